@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "breutil/buffer.hpp"
+#include "breutil/simd_scan.hpp"
+
+// 改造前 Buffer::FindCRLF 的逐字节循环，作为对照
+static const char* LegacyFindCRLF(const char* start, const char* end) {
+    for (const char* p = start; p + 1 < end; ++p) {
+        if (p[0] == '\r' && p[1] == '\n') {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+// 构造一段只在末尾出现 "\r\n" 的数据，强制扫描整个区间
+static std::string MakeLine(size_t len) {
+    std::string line(len, 'a');
+    for (size_t i = 0; i < len; i += 7) {
+        line[i] = '\r';  // 孤立的 '\r' 让双字节匹配不能只看首字节
+    }
+    line[len - 2] = '\r';
+    line[len - 1] = '\n';
+    return line;
+}
+
+template <typename Finder>
+static void RunFindCRLF(benchmark::State& state, Finder finder) {
+    const std::string line = MakeLine(static_cast<size_t>(state.range(0)));
+    const char* begin = line.data();
+    const char* end = line.data() + line.size();
+    for (auto _ : state) {
+        const char* p = finder(begin, end);
+        benchmark::DoNotOptimize(p);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_FindCRLF_Legacy(benchmark::State& state) {
+    RunFindCRLF(state, LegacyFindCRLF);
+}
+BENCHMARK(BM_FindCRLF_Legacy)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+static void BM_FindCRLF_Scalar(benchmark::State& state) {
+    RunFindCRLF(state, [](const char* b, const char* e) {
+        return bre::simd::FindPairScalar(b, e, '\r', '\n');
+    });
+}
+BENCHMARK(BM_FindCRLF_Scalar)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+#ifdef BRE_SIMD_X86
+static void BM_FindCRLF_SSE2(benchmark::State& state) {
+    RunFindCRLF(state, [](const char* b, const char* e) {
+        return bre::simd::FindPairSse2(b, e, '\r', '\n');
+    });
+}
+BENCHMARK(BM_FindCRLF_SSE2)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+static void BM_FindCRLF_AVX2(benchmark::State& state) {
+    if (!bre::simd::HasAvx2()) {
+        state.SkipWithError("AVX2 not supported");
+        return;
+    }
+    RunFindCRLF(state, [](const char* b, const char* e) {
+        return bre::simd::FindPairAvx2(b, e, '\r', '\n');
+    });
+}
+BENCHMARK(BM_FindCRLF_AVX2)->RangeMultiplier(16)->Range(64, 1 << 20);
+#endif
+
+static void BM_Buffer_FindCRLF(benchmark::State& state) {
+    bre::Buffer buffer;
+    buffer.Append(MakeLine(static_cast<size_t>(state.range(0))));
+    for (auto _ : state) {
+        const char* p = buffer.FindCRLF();
+        benchmark::DoNotOptimize(p);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Buffer_FindCRLF)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+// 连续小块追加：对比按需精确扩容与默认的几何增长
+static void RunAppendSmall(benchmark::State& state, double factor) {
+    const auto total = static_cast<size_t>(state.range(0));
+    const char chunk[16] = "0123456789abcde";
+    bre::Buffer::GrowthPolicy policy;
+    policy.factor = factor;
+    for (auto _ : state) {
+        bre::Buffer buffer(64);
+        buffer.SetGrowthPolicy(policy);
+        for (size_t written = 0; written < total; written += sizeof(chunk)) {
+            buffer.Append(chunk, sizeof(chunk));
+        }
+        benchmark::DoNotOptimize(buffer.Peek());
+        state.counters["reallocs"] = static_cast<double>(buffer.GetGrowthStats().reallocations);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_Buffer_Append_ExactFit(benchmark::State& state) {
+    RunAppendSmall(state, 1.0);
+}
+BENCHMARK(BM_Buffer_Append_ExactFit)->RangeMultiplier(16)->Range(4096, 1 << 16);  // 1 MiB 需要数秒
+
+static void BM_Buffer_Append_Geometric(benchmark::State& state) {
+    RunAppendSmall(state, 2.0);
+}
+BENCHMARK(BM_Buffer_Append_Geometric)->RangeMultiplier(16)->Range(4096, 1 << 20);
@@ -0,0 +1,354 @@
+#include <benchmark/benchmark.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "breutil/async_queue.hpp"
+#include "breutil/block_queue.hpp"
+#include "breutil/broadcast_ring.hpp"
+#include "breutil/event_queue.hpp"
+#include "breutil/mpmc_queue.hpp"
+#include "breutil/sharded_queue.hpp"
+#include "breutil/spsc_queue.hpp"
+#include "breutil/unbounded_queue.hpp"
+
+// 每个线程交替 Push/Pop，所有线程共享同一个队列，测量争用下的吞吐
+template <typename Queue>
+static void RunPushPop(benchmark::State& state, Queue& queue) {
+    int value = 0;
+    for (auto _ : state) {
+        queue.Push(1);
+        queue.Pop(value);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_BlockQueue_PushPop(benchmark::State& state) {
+    static bre::BlockQueue<int> queue(1024);
+    RunPushPop(state, queue);
+}
+BENCHMARK(BM_BlockQueue_PushPop)->ThreadRange(1, 32)->UseRealTime();
+
+// 监控/限流代码在请求路径上频繁读取队列状态，观测接口不加锁，不与 Push/Pop 争用
+static void BM_BlockQueue_Observe(benchmark::State& state) {
+    static bre::BlockQueue<int> queue(1024);
+    size_t observed = 0;
+    for (auto _ : state) {
+        observed += queue.Size() + queue.Full() + queue.IsClosed();
+    }
+    benchmark::DoNotOptimize(observed);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BlockQueue_Observe)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_MpmcQueue_PushPop(benchmark::State& state) {
+    static bre::MpmcQueue<int> queue(1024);
+    RunPushPop(state, queue);
+}
+BENCHMARK(BM_MpmcQueue_PushPop)->ThreadRange(1, 32)->UseRealTime();
+
+// 无界链表队列：节点经纪元回收后复用，稳态下不调用分配器
+static void BM_UnboundedQueue_PushPop(benchmark::State& state) {
+    static bre::UnboundedQueue<int> queue;
+    RunPushPop(state, queue);
+}
+BENCHMARK(BM_UnboundedQueue_PushPop)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_ShardedQueue_PushPop(benchmark::State& state) {
+    static bre::ShardedQueue<int> queue(1024);
+    RunPushPop(state, queue);
+}
+BENCHMARK(BM_ShardedQueue_PushPop)->ThreadRange(1, 32)->UseRealTime();
+
+// 一个生产者线程与一个消费者线程之间的交接吞吐
+template <typename Queue>
+static void RunHandoff(benchmark::State& state, Queue& queue) {
+    const int count = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        std::thread producer([&queue, count]() {
+            for (int i = 0; i < count; ++i) {
+                queue.Push(i);
+            }
+        });
+        int value = 0;
+        for (int i = 0; i < count; ++i) {
+            queue.Pop(value);
+        }
+        producer.join();
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_BlockQueue_Handoff(benchmark::State& state) {
+    bre::BlockQueue<int> queue(1024);
+    RunHandoff(state, queue);
+}
+BENCHMARK(BM_BlockQueue_Handoff)->Arg(1 << 16)->UseRealTime();
+
+static void BM_SpscQueue_Handoff(benchmark::State& state) {
+    bre::SpscQueue<int, 1024> queue;
+    RunHandoff(state, queue);
+}
+BENCHMARK(BM_SpscQueue_Handoff)->Arg(1 << 16)->UseRealTime();
+
+static void BM_SpscQueue_Handoff_Spin(benchmark::State& state) {
+    bre::SpscQueue<int, 1024, false> queue;
+    RunHandoff(state, queue);
+}
+BENCHMARK(BM_SpscQueue_Handoff_Spin)->Arg(1 << 16)->UseRealTime();
+
+// 立即开始执行、结束时自行销毁的协程
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+static Detached AsyncProduce(bre::AsyncQueue<int>& queue, int count) {
+    for (int i = 0; i < count; ++i) {
+        co_await queue.PushAsync(i);
+    }
+}
+
+static Detached AsyncConsume(bre::AsyncQueue<int>& queue, int count, int& last) {
+    for (int i = 0; i < count; ++i) {
+        last = *co_await queue.PopAsync();
+    }
+}
+
+// 同一线程上两个协程经由 AsyncQueue 交接，队列满/空时挂起与恢复代替线程阻塞与唤醒
+static void BM_AsyncQueue_CoroutineHandoff(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    bre::AsyncQueue<int> queue(1024);
+    int last = 0;
+    for (auto _ : state) {
+        AsyncConsume(queue, count, last);
+        AsyncProduce(queue, count);
+        benchmark::DoNotOptimize(last);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_AsyncQueue_CoroutineHandoff)->Arg(1 << 16)->UseRealTime();
+
+#ifdef __linux__
+// 事件循环式消费：epoll 等待 eventfd 可读，每次唤醒取走整批，统计每次唤醒平均取到的元素数
+static void BM_EventQueue_ReactorHandoff(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    bre::EventQueue<int> queue(1024);
+    const int epfd = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ::epoll_ctl(epfd, EPOLL_CTL_ADD, queue.Fd(), &ev);
+
+    std::vector<int> batch;
+    batch.reserve(1024);
+    int64_t wakeups = 0;
+    for (auto _ : state) {
+        std::thread producer([&queue, count]() {
+            for (int i = 0; i < count; ++i) {
+                queue.Push(i);
+            }
+        });
+        for (int received = 0; received < count;) {
+            epoll_event out{};
+            ::epoll_wait(epfd, &out, 1, -1);
+            ++wakeups;
+            batch.clear();
+            received += static_cast<int>(queue.TryPopAll(std::back_inserter(batch)));
+        }
+        producer.join();
+        benchmark::DoNotOptimize(batch.data());
+    }
+    ::close(epfd);
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["items_per_wakeup"] = static_cast<double>(state.iterations() * count) / wakeups;
+}
+BENCHMARK(BM_EventQueue_ReactorHandoff)->Arg(1 << 16)->UseRealTime();
+#endif
+
+// 一个生产者把每个事件发给 n 个消费者：每个消费者一个 BlockQueue（事件复制 n 份）与共享一个广播环的对比
+static void BM_BlockQueue_BroadcastFanOut(benchmark::State& state) {
+    const int consumers = static_cast<int>(state.range(0));
+    const int events = 1 << 16;
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<bre::BlockQueue<int64_t>>> queues;
+        std::vector<std::thread> threads;
+        for (int c = 0; c < consumers; ++c) {
+            queues.push_back(std::make_unique<bre::BlockQueue<int64_t>>(1024));
+            threads.emplace_back([&queue = *queues.back()]() {
+                std::vector<int64_t> out;
+                int64_t sum = 0;
+                while (queue.Pop(std::back_inserter(out), 256) > 0) {
+                    for (int64_t v : out) sum += v;
+                    out.clear();
+                }
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+        for (int64_t i = 0; i < events; ++i) {
+            for (auto& queue : queues) {
+                queue->Push(i);
+            }
+        }
+        for (auto& queue : queues) queue->Close();
+        for (auto& t : threads) t.join();
+    }
+    state.SetItemsProcessed(state.iterations() * events);
+}
+BENCHMARK(BM_BlockQueue_BroadcastFanOut)->Arg(1)->Arg(4)->UseRealTime();
+
+static void BM_BroadcastRing_FanOut(benchmark::State& state) {
+    using Ring = bre::BroadcastRing<int64_t, 1024>;
+    const int consumers = static_cast<int>(state.range(0));
+    const int events = 1 << 16;
+    for (auto _ : state) {
+        Ring ring;
+        std::vector<std::thread> threads;
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([sub = ring.Subscribe()]() mutable {
+                int64_t sum = 0;
+                while (sub.Poll([&sum](const int64_t& v) { sum += v; }) > 0) {
+                }
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+        for (int64_t i = 0; i < events; ++i) {
+            ring.Publish(i);
+        }
+        ring.Close();
+        for (auto& t : threads) t.join();
+    }
+    state.SetItemsProcessed(state.iterations() * events);
+}
+BENCHMARK(BM_BroadcastRing_FanOut)->Arg(1)->Arg(4)->UseRealTime();
+
+// 一个生产者批量 Push，多个消费者批量 Pop，统计条件变量的唤醒情况
+static void BM_BlockQueue_BatchFanOut(benchmark::State& state) {
+    const int consumers = static_cast<int>(state.range(0));
+    const int batches = 2000;
+    const std::vector<int> batch(16, 1);
+    bre::BlockQueue<int>::WakeupStats stats;
+    for (auto _ : state) {
+        bre::BlockQueue<int> queue(256);
+        std::vector<std::thread> threads;
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&queue]() {
+                std::vector<int> out;
+                out.reserve(64);
+                while (queue.Pop(std::back_inserter(out), 64) > 0) {
+                    out.clear();
+                }
+            });
+        }
+        for (int i = 0; i < batches;) {
+            if (queue.Push(batch.begin(), batch.end()) == batch.size()) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        queue.Close();
+        for (auto& t : threads) t.join();
+        stats = queue.GetWakeupStats();
+    }
+    state.counters["wakeups"] = static_cast<double>(stats.wakeups);
+    state.counters["futile"] = static_cast<double>(stats.futileWakeups);
+    state.SetItemsProcessed(state.iterations() * batches * static_cast<int64_t>(batch.size()));
+}
+BENCHMARK(BM_BlockQueue_BatchFanOut)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+// 消费者一次取走 n 个积压元素：批量 Pop 在锁内逐个搬移，DrainAll 在锁内只交换存储
+// 只计取出的耗时；每次迭代都要重新填满队列，因此固定迭代次数
+template <typename Drain>
+static void RunDrainBacklog(benchmark::State& state, Drain drain) {
+    const auto backlog = static_cast<size_t>(state.range(0));
+    bre::BlockQueue<int> queue(backlog);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (size_t i = 0; i < backlog; ++i) {
+            queue.TryPush(static_cast<int>(i));
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(drain(queue));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BlockQueue_Drain_PopBatch(benchmark::State& state) {
+    std::vector<int> out;
+    RunDrainBacklog(state, [&out](bre::BlockQueue<int>& queue) {
+        out.clear();
+        return queue.Pop(std::back_inserter(out), out.max_size());
+    });
+}
+BENCHMARK(BM_BlockQueue_Drain_PopBatch)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1000);
+
+static void BM_BlockQueue_DrainAll_Vector(benchmark::State& state) {
+    std::vector<int> out;
+    RunDrainBacklog(state, [&out](bre::BlockQueue<int>& queue) {
+        out.clear();
+        return queue.DrainAll(out);
+    });
+}
+BENCHMARK(BM_BlockQueue_DrainAll_Vector)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1000);
+
+static void BM_BlockQueue_DrainAll_Swap(benchmark::State& state) {
+    bre::RingBuffer<int> out;
+    RunDrainBacklog(state, [&out](bre::BlockQueue<int>& queue) {
+        out.Clear();
+        return queue.DrainAll(out);
+    });
+}
+BENCHMARK(BM_BlockQueue_DrainAll_Swap)->Arg(1 << 10)->Arg(1 << 16)->Iterations(1000);
+
+// 生产者间隔几微秒发送时间戳，消费者统计从 Push 到 Pop 返回的交接延迟
+static void BM_BlockQueue_HandoffLatency(benchmark::State& state) {
+    using Clock = std::chrono::steady_clock;
+    const auto strategy = static_cast<bre::WaitStrategy>(state.range(0));
+    const int messages = 2000;
+    const auto gap = std::chrono::microseconds(5);
+    std::vector<int64_t> latencies;
+    latencies.reserve(static_cast<size_t>(messages) * 16);
+    for (auto _ : state) {
+        bre::BlockQueue<Clock::time_point> queue(64, strategy);
+        std::thread consumer([&queue, &latencies]() {
+            Clock::time_point sent;
+            while (queue.Pop(sent)) {
+                latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - sent).count());
+            }
+        });
+        for (int i = 0; i < messages; ++i) {
+            const auto now = Clock::now();
+            queue.Push(now);
+            while (Clock::now() - now < gap) {
+            }
+        }
+        queue.Close();
+        consumer.join();
+    }
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_ns"] = static_cast<double>(latencies[latencies.size() / 2]);
+    state.counters["p99_ns"] = static_cast<double>(latencies[latencies.size() * 99 / 100]);
+}
+BENCHMARK(BM_BlockQueue_HandoffLatency)
+    ->Arg(static_cast<int>(bre::WaitStrategy::Block))
+    ->Arg(static_cast<int>(bre::WaitStrategy::YieldThenBlock))
+    ->Arg(static_cast<int>(bre::WaitStrategy::SpinThenBlock))
+    ->Iterations(5)
+    ->UseRealTime();
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "breutil/block_queue.hpp"
+#include "breutil/thread_pool.hpp"
+
+// 对照组：所有线程共享一个 BlockQueue 的朴素线程池
+class SharedQueuePool {
+public:
+    explicit SharedQueuePool(size_t threadCount) : _queue(1 << 16) {
+        for (size_t i = 0; i < threadCount; ++i) {
+            _threads.emplace_back([this]() {
+                std::function<void()> task;
+                while (_queue.Pop(task)) {
+                    task();
+                }
+            });
+        }
+    }
+
+    ~SharedQueuePool() {
+        _queue.Close();
+        for (auto& t : _threads) {
+            t.join();
+        }
+    }
+
+    template <typename F>
+    void Post(F&& f) {
+        _queue.Push(std::function<void()>(std::forward<F>(f)));
+    }
+
+private:
+    bre::BlockQueue<std::function<void()>> _queue;
+    std::vector<std::thread> _threads;
+};
+
+// 二叉分叉到指定深度，叶子完成时计数，最后一个叶子唤醒等待的主线程
+template <typename Pool>
+static void Fork(Pool& pool, int depth, std::atomic<int>& remaining) {
+    if (depth == 0) {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            remaining.notify_all();
+        }
+        return;
+    }
+    for (int i = 0; i < 2; ++i) {
+        pool.Post([&pool, depth, &remaining]() {
+            Fork(pool, depth - 1, remaining);
+        });
+    }
+}
+
+template <typename Pool>
+static void RunForkJoin(benchmark::State& state, Pool& pool) {
+    const int depth = 12;
+    for (auto _ : state) {
+        std::atomic<int> remaining{1 << depth};
+        Fork(pool, depth, remaining);
+        for (int left = remaining.load(); left > 0; left = remaining.load()) {
+            remaining.wait(left);
+        }
+    }
+    // 每轮共 2^(depth+1) - 2 个任务
+    state.SetItemsProcessed(state.iterations() * ((2 << depth) - 2));
+}
+
+static void BM_ThreadPool_ForkJoin(benchmark::State& state) {
+    bre::ThreadPool pool(state.range(0));
+    RunForkJoin(state, pool);
+}
+BENCHMARK(BM_ThreadPool_ForkJoin)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+// 改用 Submit 提交并丢弃 future，与 Post 对比可以看出 future 共享状态的开销
+struct SubmitAdaptor {
+    bre::ThreadPool& pool;
+
+    template <typename F>
+    void Post(F&& f) {
+        pool.Submit(std::forward<F>(f));
+    }
+};
+
+static void BM_ThreadPool_ForkJoin_Submit(benchmark::State& state) {
+    bre::ThreadPool pool(state.range(0));
+    SubmitAdaptor adaptor{pool};
+    RunForkJoin(state, adaptor);
+}
+BENCHMARK(BM_ThreadPool_ForkJoin_Submit)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+static void BM_SharedBlockQueue_ForkJoin(benchmark::State& state) {
+    SharedQueuePool pool(state.range(0));
+    RunForkJoin(state, pool);
+}
+BENCHMARK(BM_SharedBlockQueue_ForkJoin)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+// 大量细粒度下标的并行循环
+static void BM_ThreadPool_ParallelFor(benchmark::State& state) {
+    bre::ThreadPool pool(state.range(0));
+    std::vector<int> data(1 << 16);
+    for (auto _ : state) {
+        pool.ParallelFor(size_t(0), data.size(), [&data](size_t i) {
+            data[i] = static_cast<int>(i * 2654435761u);
+        });
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetItemsProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_ThreadPool_ParallelFor)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
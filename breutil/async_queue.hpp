@@ -0,0 +1,282 @@
+#pragma once
+
+/** async_queue.hpp
+ * 面向 C++20 协程的有界队列。
+ * co_await PopAsync() / co_await PushAsync(x) 在条件不满足时挂起协程而不是阻塞线程：
+ * 等待者以侵入式链表挂在队列上（不额外分配内存），Push 遇到挂起的消费者时直接把元素交给它，
+ * Pop 腾出空位时把挂起的生产者的元素放入队列，然后把被唤醒的协程交给执行器恢复。
+ *
+ * 执行器为空时在唤醒方的线程上直接恢复（唤醒方的调用返回前协程就会运行到下一个挂起点）；
+ * 传入执行器可以把恢复调度到线程池等处，例如 [&pool](std::coroutine_handle<> h) { pool.Post(h); }。
+ * Close 会取消所有挂起的等待：PopAsync 返回空，PushAsync 返回 false；剩余元素仍可取出。
+ * 容量为 0 时退化为同步交接：Push 只有遇到挂起的消费者才能成功。
+ */
+
+#include <coroutine>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "ring_buffer.hpp"
+
+namespace bre {
+
+template <class T>
+class AsyncQueue {
+public:
+    using Executor = std::function<void(std::coroutine_handle<>)>;
+
+    class PopAwaiter;
+    class PushAwaiter;
+
+    /**
+     * @param MaxCapacity 容量
+     * @param executor 恢复被唤醒协程的执行器，为空时在唤醒方线程上直接恢复
+     */
+    explicit AsyncQueue(size_t MaxCapacity = 1024, Executor executor = nullptr)
+        : _capacity(MaxCapacity), _queue(MaxCapacity), _executor(std::move(executor)) {}
+
+    // 挂起的协程引用着队列，析构前应先 Close 并让它们恢复
+    ~AsyncQueue() { Close(); }
+
+    // 禁止拷贝和移动，挂起的等待者持有队列指针
+    AsyncQueue(const AsyncQueue &) = delete;
+    AsyncQueue &operator=(const AsyncQueue &) = delete;
+
+    /**
+     * @brief 关闭队列，取消所有挂起的 PopAsync/PushAsync；之后的 Push 失败
+     */
+    void Close() {
+        std::vector<std::coroutine_handle<>> ready;
+        {
+            std::lock_guard<std::mutex> locker(_mtx);
+            _isClose = true;
+            while (PopAwaiter *waiter = _consumers.Pop()) {
+                ready.push_back(waiter->_handle);
+            }
+            while (PushAwaiter *waiter = _producers.Pop()) {
+                ready.push_back(waiter->_handle);
+            }
+        }
+        for (auto handle : ready) {
+            dispatch(handle);
+        }
+    }
+
+    bool IsClosed() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _isClose;
+    }
+
+    size_t Size() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _queue.Size();
+    }
+
+    bool Empty() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _queue.Empty();
+    }
+
+    size_t Capacity() const { return _capacity; }
+
+    // 非阻塞 Push，如果队列满或已关闭则返回 false；有挂起的消费者时直接交给它
+    bool TryPush(const T &item) { return tryPush(item); }
+
+    bool TryPush(T &&item) { return tryPush(std::move(item)); }
+
+    // 非阻塞 Pop；腾出空位时唤醒一个挂起的生产者
+    std::optional<T> TryPop() {
+        std::optional<T> item;
+        std::coroutine_handle<> ready;
+        {
+            std::lock_guard<std::mutex> locker(_mtx);
+            tryPopLocked(item, ready);
+        }
+        dispatch(ready);
+        return item;
+    }
+
+    /**
+     * @brief co_await 得到 std::optional<T>：队列空时挂起，关闭且取空时为空
+     */
+    [[nodiscard]] PopAwaiter PopAsync() { return PopAwaiter(*this); }
+
+    /**
+     * @brief co_await 得到 bool：队列满时挂起，元素放入（或交给消费者）后为 true，关闭时为 false
+     */
+    [[nodiscard]] PushAwaiter PushAsync(T item) { return PushAwaiter(*this, std::move(item)); }
+
+    class PopAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        // 能立即取到元素或队列已关闭时不挂起
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::coroutine_handle<> ready;
+            {
+                std::lock_guard<std::mutex> locker(_owner._mtx);
+                if (!_owner.tryPopLocked(_item, ready) && !_owner._isClose) {
+                    _handle = handle;
+                    _owner._consumers.Push(this);
+                    return true;
+                }
+            }
+            _owner.dispatch(ready);
+            return false;
+        }
+
+        std::optional<T> await_resume() { return std::move(_item); }
+
+    private:
+        friend class AsyncQueue;
+
+        explicit PopAwaiter(AsyncQueue &owner) : _owner(owner) {}
+
+        AsyncQueue &_owner;
+        std::coroutine_handle<> _handle;
+        std::optional<T> _item;
+        PopAwaiter *_next = nullptr;
+    };
+
+    class PushAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        // 能立即放入或队列已关闭时不挂起
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::coroutine_handle<> ready;
+            {
+                std::lock_guard<std::mutex> locker(_owner._mtx);
+                if (_owner._isClose) {
+                    return false;
+                }
+                _ok = _owner.tryPushLocked(std::move(_item), ready);
+                if (!_ok) {
+                    _handle = handle;
+                    _owner._producers.Push(this);
+                    return true;
+                }
+            }
+            _owner.dispatch(ready);
+            return false;
+        }
+
+        bool await_resume() const noexcept { return _ok; }
+
+    private:
+        friend class AsyncQueue;
+
+        PushAwaiter(AsyncQueue &owner, T &&item) : _owner(owner), _item(std::move(item)) {}
+
+        AsyncQueue &_owner;
+        std::coroutine_handle<> _handle;
+        T _item;
+        bool _ok = false;
+        PushAwaiter *_next = nullptr;
+    };
+
+private:
+    // 按挂起顺序唤醒的侵入式 FIFO 链表，节点就是协程帧中的 awaiter
+    template <typename Node>
+    struct WaitList {
+        Node *head = nullptr;
+        Node *tail = nullptr;
+
+        void Push(Node *node) {
+            node->_next = nullptr;
+            if (tail) {
+                tail->_next = node;
+            } else {
+                head = node;
+            }
+            tail = node;
+        }
+
+        Node *Pop() {
+            Node *node = head;
+            if (node) {
+                head = node->_next;
+                if (!head) {
+                    tail = nullptr;
+                }
+            }
+            return node;
+        }
+    };
+
+    // 必须在锁外调用；恢复后 awaiter 可能已随协程帧销毁，调用后不能再访问
+    void dispatch(std::coroutine_handle<> handle) {
+        if (!handle) {
+            return;
+        }
+        if (_executor) {
+            _executor(handle);
+        } else {
+            handle.resume();
+        }
+    }
+
+    // 有挂起的消费者时队列必为空，直接交接；否则放入队列。失败时 item 不会被移走
+    template <typename U>
+    bool tryPushLocked(U &&item, std::coroutine_handle<> &ready) {
+        if (_isClose) {
+            return false;
+        }
+        if (PopAwaiter *waiter = _consumers.Pop()) {
+            waiter->_item.emplace(std::forward<U>(item));
+            ready = waiter->_handle;
+            return true;
+        }
+        if (_queue.Size() >= _capacity) {
+            return false;
+        }
+        _queue.EmplaceBack(std::forward<U>(item));
+        return true;
+    }
+
+    // 取出队首后用一个挂起的生产者的元素补上空位；容量为 0 时直接从生产者手中取
+    bool tryPopLocked(std::optional<T> &item, std::coroutine_handle<> &ready) {
+        PushAwaiter *waiter = nullptr;
+        if (!_queue.Empty()) {
+            item.emplace(std::move(_queue.Front()));
+            _queue.PopFront();
+            if ((waiter = _producers.Pop())) {
+                _queue.EmplaceBack(std::move(waiter->_item));
+            }
+        } else if ((waiter = _producers.Pop())) {
+            item.emplace(std::move(waiter->_item));
+        } else {
+            return false;
+        }
+        if (waiter) {
+            waiter->_ok = true;
+            ready = waiter->_handle;
+        }
+        return true;
+    }
+
+    template <typename U>
+    bool tryPush(U &&item) {
+        std::coroutine_handle<> ready;
+        bool ok;
+        {
+            std::lock_guard<std::mutex> locker(_mtx);
+            ok = tryPushLocked(std::forward<U>(item), ready);
+        }
+        dispatch(ready);
+        return ok;
+    }
+
+    const size_t _capacity;
+    bool _isClose = false;
+    RingBuffer<T> _queue;
+    WaitList<PopAwaiter> _consumers;
+    WaitList<PushAwaiter> _producers;
+    Executor _executor;
+    mutable std::mutex _mtx;
+};
+
+}  // namespace bre
@@ -1,17 +1,45 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <optional>
-#include <queue>
+#include <stdexcept>
+#include <thread>
+
+#include "queue_metrics.hpp"
+#include "ring_buffer.hpp"
+#include "spin_wait.hpp"
 
 namespace bre {
 
+// 带超时的批量 Push 的放入方式
+enum class BatchPush {
+    AllOrNothing,  // 等到能一次放下全部元素才放入，超时则一个也不放
+    Partial,       // 有空位就放入，直到全部放入、超时或队列关闭
+};
+
 template <class T>
 class BlockQueue {
 public:
-    explicit BlockQueue(size_t MaxCapacity = 1024) : _capacity(MaxCapacity), _isClose(false) {}
+    // 唤醒统计，用于观察条件变量的通知是否有效
+    struct WakeupStats {
+        size_t notifications = 0;         // 实际唤醒的等待者个数
+        size_t skippedNotifications = 0;  // 因无人等待而省掉的通知
+        size_t wakeups = 0;               // 等待者从条件变量返回的次数（不含超时）
+        size_t futileWakeups = 0;         // 返回后条件仍不满足、只能继续等待的次数
+    };
+
+    /**
+     * @param MaxCapacity 容量，存储一次性分配，之后的 Push/Pop 不再申请内存
+     * @param strategy 阻塞的 Push/Pop 在挂起前是否先自旋，见 WaitStrategy
+     */
+    explicit BlockQueue(size_t MaxCapacity = 1024, WaitStrategy strategy = WaitStrategy::Block)
+        : _capacity(MaxCapacity), _isClose(false), _queue(MaxCapacity), _waitStrategy(strategy) {
+        _metrics.SetCapacity(MaxCapacity);
+    }
 
     ~BlockQueue() { Close(); }
 
@@ -25,231 +53,285 @@ public:
 
     void Clear() {
         std::lock_guard<std::mutex> locker(_mtx);
-        _queue = std::queue<T>();
-        _condProducer.notify_all();
+        const size_t freed = _queue.Size();
+        _queue.Clear();  // 只析构元素，保留存储
+        _size.store(0, std::memory_order_relaxed);
+        _metrics.OnClear();
+        notifyProducers(freed);
     }
 
-    bool Empty() const {
-        std::lock_guard<std::mutex> locker(_mtx);
-        return _queue.empty();
-    }
+    /**
+     * 以下观测接口（Empty/Full/IsClosed/Size/Capacity）不加锁，读取的是原子镜像的 relaxed 快照：
+     * 返回时状态可能已被其他线程改变，各值之间也不保证同一时刻，适合监控与限流判断；
+     * 需要据此做决定时应使用 TryPush/TryPop 等在锁内判断的接口
+     */
+    bool Empty() const { return Size() == 0; }
 
-    bool Full() const {
-        std::lock_guard<std::mutex> locker(_mtx);
-        return _queue.size() >= _capacity;
-    }
+    bool Full() const { return Size() >= Capacity(); }
 
     void Close() {
         {
             std::lock_guard<std::mutex> locker(_mtx);
-            _isClose = true;
+            _isClose.store(true, std::memory_order_release);
         }
         _condProducer.notify_all();
         _condConsumer.notify_all();
+        _condBatch.notify_all();
     }
 
-    bool IsClosed() const {
-        std::lock_guard<std::mutex> locker(_mtx);
-        return _isClose;
-    }
+    // 关闭后不会再打开，返回 true 即为确定的结果
+    bool IsClosed() const { return _isClose.load(std::memory_order_acquire); }
 
-    size_t Size() const {
-        std::lock_guard<std::mutex> locker(_mtx);
-        return _queue.size();
-    }
+    size_t Size() const { return _size.load(std::memory_order_relaxed); }
 
-    size_t Capacity() const {
-        std::lock_guard<std::mutex> locker(_mtx);
-        return _capacity;
-    }
+    size_t Capacity() const { return _capacity.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 设置等待策略，对之后开始等待的线程生效
+     */
+    void SetWaitStrategy(WaitStrategy strategy) { _waitStrategy.store(strategy, std::memory_order_relaxed); }
+
+    WaitStrategy GetWaitStrategy() const { return _waitStrategy.load(std::memory_order_relaxed); }
 
     // 动态调整容量
     void SetCapacity(size_t newCapacity) {
         std::lock_guard<std::mutex> locker(_mtx);
-        _capacity = newCapacity;
-        if (_queue.size() < _capacity) {
-            _condProducer.notify_all();  // 容量增加，通知等待的生产者
+        _capacity.store(newCapacity, std::memory_order_relaxed);
+        // 缩容时不能丢弃已有元素，存储至少保留当前元素个数
+        const size_t storage = newCapacity > _queue.Size() ? newCapacity : _queue.Size();
+        if (storage != _queue.Capacity()) {
+            _queue.Reallocate(storage);
+        }
+        _metrics.SetCapacity(storage);
+        if (_queue.Size() < newCapacity) {
+            notifyProducers(newCapacity - _queue.Size());  // 容量增加，通知等待的生产者
         }
     }
 
     T Front() const {  // 新增：获取队首元素
         std::lock_guard<std::mutex> locker(_mtx);
-        if (_queue.empty()) {
+        if (_queue.Empty()) {
             throw std::runtime_error("Queue is empty");
         }
-        return _queue.front();
+        return _queue.Front();
     }
 
     T Back() const {  // 添加 const
         std::lock_guard<std::mutex> locker(_mtx);
-        if (_queue.empty()) {
+        if (_queue.Empty()) {
             throw std::runtime_error("Queue is empty");
         }
-        return _queue.back();
+        return _queue.Back();
     }
 
     // 非阻塞 Push，如果队列满则返回 false
-    bool TryPush(const T &item) {
-        std::lock_guard<std::mutex> locker(_mtx);
-        if (_isClose || _queue.size() >= _capacity) {
-            return false;
-        }
-        _queue.push(item);
-        _condConsumer.notify_one();
-        return true;
-    }
+    bool TryPush(const T &item) { return TryEmplace(item); }
+
+    bool TryPush(T &&item) { return TryEmplace(std::move(item)); }
 
-    bool TryPush(T &&item) {
+    /**
+     * @brief 非阻塞地在队尾原地构造元素，队列满或已关闭时返回 false，此时参数不会被移走
+     */
+    template <typename... Args>
+    bool TryEmplace(Args &&...args) {
         std::lock_guard<std::mutex> locker(_mtx);
-        if (_isClose || _queue.size() >= _capacity) {
+        if (_isClose || fullLocked()) {
+            rejectLocked();
             return false;
         }
-        _queue.push(std::move(item));
-        _condConsumer.notify_one();
+        pushLocked(std::forward<Args>(args)...);
+        notifyConsumers(1);
         return true;
     }
 
-    void Push(const T &item) {
-        std::unique_lock<std::mutex> locker(_mtx);
-        _condProducer.wait(locker, [this] {
-            return _isClose || _queue.size() < _capacity;
-        });
-        if (_isClose) {
-            throw std::runtime_error("Queue is closed");
-        }
-        _queue.push(item);
-        _condConsumer.notify_one();
-    }
+    void Push(const T &item) { Emplace(item); }
 
-    void Push(T &&item) {
+    void Push(T &&item) { Emplace(std::move(item)); }
+
+    /**
+     * @brief 在队尾原地构造元素，队列满时阻塞
+     * @throw std::runtime_error 队列已关闭
+     */
+    template <typename... Args>
+    void Emplace(Args &&...args) {
+        spinUntilNotFull();
         std::unique_lock<std::mutex> locker(_mtx);
-        _condProducer.wait(locker, [this] {
-            return _isClose || _queue.size() < _capacity;
+        waitOn(_condProducer, _waitingProducers, _producerSpin, locker, [this] {
+            return _isClose || !fullLocked();
         });
         if (_isClose) {
             throw std::runtime_error("Queue is closed");
         }
-        _queue.push(std::move(item));
-        _condConsumer.notify_one();
+        pushLocked(std::forward<Args>(args)...);
+        notifyConsumers(1);
     }
 
-    // 支持超时的 Push
+    // 支持超时的 Push，超时精度取决于 steady_clock，可以传入微秒级的时长
     template <typename Rep, typename Period>
     bool Push(const T &item, const std::chrono::duration<Rep, Period> &timeout) {
-        std::unique_lock<std::mutex> locker(_mtx);
-        if (!_condProducer.wait_for(locker, timeout, [this] {
-                return _isClose || _queue.size() < _capacity;
-            })) {
-            return false;
-        }
-        if (_isClose) {
-            return false;
-        }
-        _queue.push(item);
-        _condConsumer.notify_one();
-        return true;
+        return PushUntil(item, DeadlineAfter(timeout));
     }
 
     template <typename Rep, typename Period>
     bool Push(T &&item, const std::chrono::duration<Rep, Period> &timeout) {
-        std::unique_lock<std::mutex> locker(_mtx);
-        if (!_condProducer.wait_for(locker, timeout, [this] {
-                return _isClose || _queue.size() < _capacity;
-            })) {
-            return false;
-        }
-        if (_isClose) {
-            return false;
-        }
-        _queue.push(std::move(item));
-        _condConsumer.notify_one();
-        return true;
+        return PushUntil(std::move(item), DeadlineAfter(timeout));
+    }
+
+    /**
+     * @brief 放入元素，队列满时最多等到 deadline
+     * 多次等待可以共用同一个截止时间；虚假唤醒和无效唤醒只会重新等待到同一截止时间，不会延长总时长
+     * @return 是否放入；队列已关闭时返回 false
+     */
+    bool PushUntil(const T &item, std::chrono::steady_clock::time_point deadline) {
+        return emplaceUntil(deadline, item);
+    }
+
+    bool PushUntil(T &&item, std::chrono::steady_clock::time_point deadline) {
+        return emplaceUntil(deadline, std::move(item));
     }
 
     // 非阻塞
     std::optional<T> TryPop() {
         std::lock_guard<std::mutex> locker(_mtx);
-        if (_queue.empty()) {
+        if (_queue.Empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(_queue.Front());
+        popFrontLocked();
+        notifyProducers(1);
+        return item;
+    }
+
+    /**
+     * @brief 阻塞地取出队首元素，以移动方式返回，不要求 T 可默认构造或赋值
+     * @return 队列关闭且为空时返回空
+     */
+    std::optional<T> Pop() {
+        spinUntilNotEmpty();
+        std::unique_lock<std::mutex> locker(_mtx);
+        waitOn(_condConsumer, _waitingConsumers, _consumerSpin, locker, [this] {
+            return _isClose || !_queue.Empty();
+        });
+        if (_queue.Empty()) {
             return std::nullopt;
         }
-        T item = std::move(_queue.front());
-        _queue.pop();
-        _condProducer.notify_one();
+        std::optional<T> item(std::move(_queue.Front()));
+        popFrontLocked();
+        notifyProducers(1);
         return item;
     }
 
     // 从队列拿走一个元素
     bool Pop(T &item) {
+        spinUntilNotEmpty();
         std::unique_lock<std::mutex> locker(_mtx);
-        _condConsumer.wait(locker, [this] {
-            return _isClose || !_queue.empty();
+        waitOn(_condConsumer, _waitingConsumers, _consumerSpin, locker, [this] {
+            return _isClose || !_queue.Empty();
         });
-        if (_isClose && _queue.empty()) {
+        if (_isClose && _queue.Empty()) {
             return false;
         }
-        item = std::move(_queue.front());
-        _queue.pop();
-        _condProducer.notify_one();
+        item = std::move(_queue.Front());
+        popFrontLocked();
+        notifyProducers(1);
         return true;
     }
 
     // 从队列查看第一个元素，不取出
-    bool Peek(T &item, int timeout_ms) {
+    bool Peek(T &item, int timeout_ms) { return PeekUntil(item, DeadlineAfter(std::chrono::milliseconds(timeout_ms))); }
+
+    template <typename Rep, typename Period>
+    bool Peek(T &item, const std::chrono::duration<Rep, Period> &timeout) {
+        return PeekUntil(item, DeadlineAfter(timeout));
+    }
+
+    bool PeekUntil(T &item, std::chrono::steady_clock::time_point deadline) {
         std::unique_lock<std::mutex> locker(_mtx);
-        if (!_condConsumer.wait_for(locker, std::chrono::milliseconds(timeout_ms), [this] {
-                return _isClose || !_queue.empty();
+        if (!waitUntil(_condConsumer, _waitingConsumers, _consumerSpin, locker, deadline, [this] {
+                return _isClose || !_queue.Empty();
             })) {
             return false;
         }
-        if (_isClose && _queue.empty()) {
+        if (_queue.Empty()) {
             return false;
         }
-        item = _queue.front();
+        item = _queue.Front();
         return true;
     }
 
-    bool Pop(T &item, int timeout_ms) {
+    /**
+     * @brief 在锁内以 const T& 访问队首元素，不拷贝也不取出；队列为空时最多等待 timeout_ms
+     * visitor 执行期间持有队列锁，不能再调用本队列的接口
+     * @return 是否访问到了元素
+     */
+    template <typename F>
+    bool PeekWith(F &&visitor, int timeout_ms = 0) {
         std::unique_lock<std::mutex> locker(_mtx);
-        if (!_condConsumer.wait_for(locker, std::chrono::milliseconds(timeout_ms), [this] {
-                return _isClose || !_queue.empty();
+        if (!waitOn(_condConsumer, _waitingConsumers, _consumerSpin, locker, std::chrono::milliseconds(timeout_ms), [this] {
+                return _isClose || !_queue.Empty();
             })) {
             return false;
         }
-        if (_isClose && _queue.empty()) {
+        if (_queue.Empty()) {
             return false;
         }
-        item = std::move(_queue.front());
-        _queue.pop();
-        _condProducer.notify_one();
+        std::forward<F>(visitor)(static_cast<const T &>(_queue.Front()));
         return true;
     }
 
+    bool Pop(T &item, int timeout_ms) { return PopUntil(item, DeadlineAfter(std::chrono::milliseconds(timeout_ms))); }
+
+    template <typename Rep, typename Period>
+    bool Pop(T &item, const std::chrono::duration<Rep, Period> &timeout) {
+        return PopUntil(item, DeadlineAfter(timeout));
+    }
+
+    /**
+     * @brief 取出队首元素，队列为空时最多等到 deadline，语义同 PushUntil
+     * @return 是否取到元素；超时或队列关闭且为空时返回 false
+     */
+    bool PopUntil(T &item, std::chrono::steady_clock::time_point deadline) {
+        return popUntil(deadline, [&item](T &&value) {
+            item = std::move(value);
+        });
+    }
+
+    std::optional<T> PopUntil(std::chrono::steady_clock::time_point deadline) {
+        std::optional<T> item;
+        popUntil(deadline, [&item](T &&value) {
+            item.emplace(std::move(value));
+        });
+        return item;
+    }
+
     /**
      * 批量操作：一次性 Push 多个元素
-     * @param first 输入迭代器的起始位置
-     * @param last 输入迭代器的结束位置
+     * 元素按 *it 的值类别转发，传入 std::make_move_iterator 时逐个移动，可用于只能移动的类型；
+     * 未能放入的元素保持原样
+     * @param first 前向迭代器的起始位置
+     * @param last 前向迭代器的结束位置
      * @return 成功放入的元素个数
      */
-    template <typename InputIt>
-    size_t Push(InputIt first, InputIt last) {
+    template <typename ForwardIt>
+    size_t Push(ForwardIt first, ForwardIt last) {
         size_t totalPushed = 0;
 
         // 判断个数是否满足全部放入，否则一个一个放入
         size_t count = std::distance(first, last);
         {
             std::lock_guard<std::mutex> locker(_mtx);
-            if (!_isClose && (_queue.size() + count <= _capacity)) {
+            if (!_isClose && (_queue.Size() + count <= _capacity.load(std::memory_order_relaxed))) {
                 for (auto it = first; it != last; ++it) {
-                    _queue.push(*it);
+                    pushLocked(*it);
                     ++totalPushed;
                 }
-                _condConsumer.notify_all();
+                notifyConsumers(totalPushed);  // 只唤醒与新元素个数相当的消费者
                 return totalPushed;
             }
         }
         // 一个一个放入
         for (auto it = first; it != last; ++it) {
-            bool result = TryPush(*it);
+            bool result = TryEmplace(*it);
             if (!result) {
                 break;
             }
@@ -261,19 +343,148 @@ public:
     // 批量操作：一次性 Pop 多个元素
     template <typename OutputIt>
     size_t Pop(OutputIt dest, size_t maxCount) {
+        spinUntilNotEmpty();
         std::unique_lock<std::mutex> locker(_mtx);
-        _condConsumer.wait(locker, [this] {
-            return _isClose || !_queue.empty();
+        waitOn(_condConsumer, _waitingConsumers, _consumerSpin, locker, [this] {
+            return _isClose || !_queue.Empty();
         });
 
-        size_t count = 0;
-        while (!_queue.empty() && count < maxCount) {
-            *dest++ = std::move(_queue.front());
-            _queue.pop();
-            ++count;
+        const size_t count = popBatchLocked(dest, maxCount);
+        notifyProducers(count);
+        return count;
+    }
+
+    /**
+     * 带超时的批量 Push
+     * @param first 前向迭代器的起始位置
+     * @param last 前向迭代器的结束位置
+     * @param timeout 最长等待时间
+     * @param mode 见 BatchPush；元素个数超过容量时 AllOrNothing 直接返回 0
+     * @return 成功放入的元素个数
+     */
+    template <typename ForwardIt, typename Rep, typename Period>
+    size_t Push(ForwardIt first, ForwardIt last, const std::chrono::duration<Rep, Period> &timeout,
+                BatchPush mode = BatchPush::AllOrNothing) {
+        const auto deadline = DeadlineAfter(timeout);
+        const size_t count = std::distance(first, last);
+        std::unique_lock<std::mutex> locker(_mtx);
+        if (mode == BatchPush::AllOrNothing) {
+            if (count > _capacity.load(std::memory_order_relaxed) ||
+                !waitUntil(_condProducer, _waitingProducers, _producerSpin, locker, deadline, [this, count] {
+                    return _isClose || freeLocked() >= count;
+                }) ||
+                _isClose) {
+                return 0;
+            }
+            for (; first != last; ++first) {
+                pushLocked(*first);
+            }
+            notifyConsumers(count);
+            return count;
+        }
+
+        size_t pushed = 0;
+        while (first != last) {
+            if (!waitUntil(_condProducer, _waitingProducers, _producerSpin, locker, deadline, [this] {
+                    return _isClose || !fullLocked();
+                }) ||
+                _isClose) {
+                break;
+            }
+            size_t round = 0;
+            for (; first != last && !fullLocked(); ++first, ++round) {
+                pushLocked(*first);
+            }
+            notifyConsumers(round);
+            pushed += round;
         }
-        if (count > 0) {
-            _condProducer.notify_all();
+        return pushed;
+    }
+
+    /**
+     * 带超时的批量 Pop：等到至少有 minCount 个元素后取出至多 maxCount 个，
+     * 用于攒批后一次性处理，摊薄下游的系统调用。
+     * 超时或队列关闭时不再等待，取出当前已有的元素（可能少于 minCount，也可能为 0）
+     * @param dest 输出迭代器
+     * @param minCount 期望的最少个数，超过 maxCount 或容量时按两者中较小者处理
+     * @param maxCount 最多取出的个数
+     * @param timeout 最长等待时间
+     * @return 取出的个数
+     */
+    template <typename OutputIt, typename Rep, typename Period>
+    size_t Pop(OutputIt dest, size_t minCount, size_t maxCount, const std::chrono::duration<Rep, Period> &timeout) {
+        const auto deadline = DeadlineAfter(timeout);
+        std::unique_lock<std::mutex> locker(_mtx);
+        minCount = std::min({minCount, maxCount, _capacity.load(std::memory_order_relaxed)});
+        const bool waits = !_isClose && _queue.Size() < minCount;
+        const auto since = waits && kQueueMetricsEnabled ? std::chrono::steady_clock::now()
+                                                         : std::chrono::steady_clock::time_point();
+        // 攒批的消费者单独等在 _condBatch 上，只有元素个数达到等待者中最小的 minCount 时才被唤醒
+        while (!_isClose && _queue.Size() < minCount) {
+            _batchThreshold = std::min(_batchThreshold, minCount);
+            ++_waitingBatchConsumers;
+            const std::cv_status status = _condBatch.wait_until(locker, deadline);
+            --_waitingBatchConsumers;
+            if (status == std::cv_status::timeout) {
+                break;
+            }
+            countWakeup(_isClose || _queue.Size() >= minCount);
+        }
+        if (waits && kQueueMetricsEnabled) {
+            _metrics.RecordPopBlocked(std::chrono::steady_clock::now() - since);
+        }
+        if (_waitingBatchConsumers == 0) {
+            _batchThreshold = kNoBatchThreshold;
+        }
+        const size_t count = popBatchLocked(dest, maxCount);
+        notifyProducers(count);
+        return count;
+    }
+
+    /**
+     * 一次取走队列中的全部元素，不等待：锁内只把内部存储与一块空存储交换（O(1)），
+     * 积压很多时临界区也不随元素个数增长，元素的搬移和旧存储的释放都在锁外进行。
+     * 开启统计时锁内还要逐个记录停留时长，但只读一次时钟。
+     * 这个重载每次调用都在锁外分配一块 Capacity() 大小的交换存储，
+     * 稳态下不分配内存的是下面 RingBuffer 版本的重载
+     * @param out 支持 push_back 的容器，元素按队列顺序追加到末尾
+     * @return 取出的个数
+     */
+    template <typename Container>
+    size_t DrainAll(Container &out) {
+        if (Empty()) {
+            return 0;  // 不为空队列分配交换用的存储
+        }
+        RingBuffer<T> drained(Capacity());
+        const size_t count = swapOut(drained);
+        if constexpr (requires { out.reserve(out.size() + count); }) {
+            out.reserve(out.size() + count);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            out.push_back(std::move(drained[i]));
+        }
+        return count;
+    }
+
+    /**
+     * out 为空时直接与内部存储交换，元素不搬移：out 的存储交给队列继续使用，
+     * 队列原来的存储连同元素换到 out 中。处理完后 Clear 再传入，两块存储来回交换，不再分配内存
+     * out 非空时取出的元素追加在原有元素之后
+     */
+    size_t DrainAll(RingBuffer<T> &out) {
+        if (out.Empty()) {
+            if (out.Capacity() < Capacity()) {
+                out.Reallocate(Capacity());  // 在锁外分配
+            }
+            return swapOut(out);
+        }
+        RingBuffer<T> drained(Capacity());
+        const size_t count = swapOut(drained);
+        if (out.Capacity() - out.Size() < count) {
+            out.Reallocate(out.Size() + count);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            out.EmplaceBack(std::move(drained[i]));
         }
         return count;
     }
@@ -285,15 +496,296 @@ public:
     void NotifyAll() {
         _condConsumer.notify_all();
         _condProducer.notify_all();
+        _condBatch.notify_all();
+    }
+
+    WakeupStats GetWakeupStats() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _wakeupStats;
+    }
+
+    /**
+     * @brief 运行时统计的快照，需编译时开启 BRE_QUEUE_METRICS（见 queue_metrics.hpp）
+     * 未开启时返回 enabled 为 false 的空快照，不加锁
+     */
+    QueueMetricsSnapshot GetMetrics() const {
+        if constexpr (kQueueMetricsEnabled) {
+            std::lock_guard<std::mutex> locker(_mtx);
+            return _metrics.Snapshot();
+        } else {
+            return {};
+        }
     }
 
 private:
-    size_t _capacity;
-    bool _isClose;
-    std::queue<T> _queue;
+    // nullopt 表示没有截止时间
+    using Deadline = std::optional<std::chrono::steady_clock::time_point>;
+
+    // 以下 *Locked 函数需持有 _mtx；_size 是元素个数的镜像，只在锁内写入，供自旋阶段和观测接口不加锁地读取
+    bool fullLocked() const { return _queue.Size() >= _capacity.load(std::memory_order_relaxed); }
+
+    size_t freeLocked() const {
+        const size_t capacity = _capacity.load(std::memory_order_relaxed);
+        return _queue.Size() < capacity ? capacity - _queue.Size() : 0;
+    }
+
+    template <typename OutputIt>
+    size_t popBatchLocked(OutputIt &dest, size_t maxCount) {
+        size_t count = 0;
+        while (!_queue.Empty() && count < maxCount) {
+            *dest++ = std::move(_queue.Front());
+            popFrontLocked();
+            ++count;
+        }
+        return count;
+    }
+
+    // 用空的 spare 换出内部存储；队列为空时不交换，spare 保持原样
+    size_t swapOut(RingBuffer<T> &spare) {
+        std::lock_guard<std::mutex> locker(_mtx);
+        const size_t count = _queue.Size();
+        if (count == 0) {
+            return 0;
+        }
+        const size_t capacity = _capacity.load(std::memory_order_relaxed);
+        if (spare.Capacity() < capacity) {
+            spare.Reallocate(capacity);  // 分配 spare 之后容量又被调大，少见
+        }
+        _queue.Swap(spare);
+        _size.store(0, std::memory_order_relaxed);
+        _metrics.OnPopBatch(count);
+        notifyProducers(count);
+        return count;
+    }
+
+    template <typename... Args>
+    void pushLocked(Args &&...args) {
+        _queue.EmplaceBack(std::forward<Args>(args)...);
+        _size.store(_queue.Size(), std::memory_order_relaxed);
+        _metrics.OnPush(_queue.Size());
+    }
+
+    void popFrontLocked() {
+        _queue.PopFront();
+        _size.store(_queue.Size(), std::memory_order_relaxed);
+        _metrics.OnPop();
+    }
+
+    template <typename... Args>
+    bool emplaceUntil(std::chrono::steady_clock::time_point deadline, Args &&...args) {
+        spinUntilNotFull(deadline);
+        std::unique_lock<std::mutex> locker(_mtx);
+        if (!waitUntil(_condProducer, _waitingProducers, _producerSpin, locker, deadline, [this] {
+                return _isClose || !fullLocked();
+            }) ||
+            _isClose) {
+            return false;
+        }
+        pushLocked(std::forward<Args>(args)...);
+        notifyConsumers(1);
+        return true;
+    }
+
+    template <typename Sink>
+    bool popUntil(std::chrono::steady_clock::time_point deadline, Sink &&sink) {
+        spinUntilNotEmpty(deadline);
+        std::unique_lock<std::mutex> locker(_mtx);
+        if (!waitUntil(_condConsumer, _waitingConsumers, _consumerSpin, locker, deadline, [this] {
+                return _isClose || !_queue.Empty();
+            }) ||
+            _queue.Empty()) {
+            return false;
+        }
+        sink(std::move(_queue.Front()));
+        popFrontLocked();
+        notifyProducers(1);
+        return true;
+    }
+
+    // TryPush 因队列满被拒绝，关闭导致的失败不计
+    void rejectLocked() {
+        if (!_isClose) {
+            _metrics.OnTryPushRejected();
+        }
+    }
+
+    /**
+     * 按等待策略在加锁前先自旋/让出，ready 成立、预算用完或到达 deadline 后返回，之后仍由调用方加锁确认。
+     * 带截止时间的调用不会因为自旋而越过截止时间
+     */
+    template <typename Ready>
+    void spinWait(AdaptiveSpin &spin, Ready ready, Deadline deadline) {
+        if (ready()) {
+            return;
+        }
+        switch (_waitStrategy.load(std::memory_order_relaxed)) {
+            case WaitStrategy::Block:
+                break;
+            case WaitStrategy::YieldThenBlock:
+                for (int i = 0; i < AdaptiveSpin::kYieldCount && !ready(); ++i) {
+                    if (deadline && std::chrono::steady_clock::now() >= *deadline) {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+                break;
+            case WaitStrategy::SpinThenBlock:
+                if (deadline) {
+                    spin.Spin(ready, *deadline);
+                } else {
+                    spin.Spin(ready);
+                }
+                break;
+        }
+    }
+
+    void spinUntilNotEmpty(Deadline deadline = std::nullopt) {
+        spinWait(
+            _consumerSpin,
+            [this] {
+                return _size.load(std::memory_order_relaxed) > 0;
+            },
+            deadline);
+    }
+
+    void spinUntilNotFull(Deadline deadline = std::nullopt) {
+        spinWait(
+            _producerSpin,
+            [this] {
+                return _size.load(std::memory_order_relaxed) < _capacity.load(std::memory_order_relaxed);
+            },
+            deadline);
+    }
+
+    // 挂起时长只有自适应自旋和统计会用到，两者都不需要时不读时钟
+    std::optional<std::chrono::steady_clock::time_point> parkStart() const {
+        if (_waitStrategy.load(std::memory_order_relaxed) != WaitStrategy::SpinThenBlock && !kQueueMetricsEnabled) {
+            return std::nullopt;
+        }
+        return std::chrono::steady_clock::now();
+    }
+
+    // 自旋后仍然挂起的时长反馈给自旋预算，并计入统计；spin 区分是生产者还是消费者在等待
+    void reportParked(AdaptiveSpin &spin, std::optional<std::chrono::steady_clock::time_point> since) {
+        if (!since) {
+            return;
+        }
+        const auto waited = std::chrono::steady_clock::now() - *since;
+        if (_waitStrategy.load(std::memory_order_relaxed) == WaitStrategy::SpinThenBlock) {
+            spin.Parked(waited);
+        }
+        if (&spin == &_producerSpin) {
+            _metrics.RecordPushBlocked(waited);
+        } else {
+            _metrics.RecordPopBlocked(waited);
+        }
+    }
+
+    // 在 cond 上等待直到 pred 成立；等待期间登记在 waiters 中，通知方据此决定唤醒几个线程
+    template <typename Pred>
+    void waitOn(std::condition_variable &cond, size_t &waiters, AdaptiveSpin &spin,
+                std::unique_lock<std::mutex> &locker, Pred pred) {
+        if (pred()) {
+            return;
+        }
+        const auto since = parkStart();
+        while (!pred()) {
+            ++waiters;
+            cond.wait(locker);
+            --waiters;
+            countWakeup(pred());
+        }
+        reportParked(spin, since);
+    }
+
+    // 带超时的版本，超时返回时 pred 的结果作为返回值
+    template <typename Rep, typename Period, typename Pred>
+    bool waitOn(std::condition_variable &cond, size_t &waiters, AdaptiveSpin &spin,
+                std::unique_lock<std::mutex> &locker, const std::chrono::duration<Rep, Period> &timeout, Pred pred) {
+        return waitUntil(cond, waiters, spin, locker, DeadlineAfter(timeout), pred);
+    }
+
+    // 等到截止时间为止；虚假唤醒不会延长总的等待时间
+    template <typename Pred>
+    bool waitUntil(std::condition_variable &cond, size_t &waiters, AdaptiveSpin &spin,
+                   std::unique_lock<std::mutex> &locker, std::chrono::steady_clock::time_point deadline, Pred pred) {
+        if (pred()) {
+            return true;
+        }
+        const auto since = parkStart();
+        bool ok = true;
+        while (!pred()) {
+            ++waiters;
+            const std::cv_status status = cond.wait_until(locker, deadline);
+            --waiters;
+            if (status == std::cv_status::timeout) {
+                ok = pred();
+                break;
+            }
+            countWakeup(pred());
+        }
+        reportParked(spin, since);
+        return ok;
+    }
+
+    void countWakeup(bool satisfied) {
+        ++_wakeupStats.wakeups;
+        if (!satisfied) {
+            ++_wakeupStats.futileWakeups;
+        }
+    }
+
+    void notifyConsumers(size_t count) {
+        notify(_condConsumer, _waitingConsumers, count);
+        if (count > 0 && _waitingBatchConsumers > 0 && _queue.Size() >= _batchThreshold) {
+            // 被唤醒的攒批消费者若仍不满足会重新登记自己的 minCount
+            _batchThreshold = kNoBatchThreshold;
+            _condBatch.notify_all();
+            _wakeupStats.notifications += _waitingBatchConsumers;
+        }
+    }
+
+    void notifyProducers(size_t count) { notify(_condProducer, _waitingProducers, count); }
+
+    // 需持有 _mtx。没有等待者时不发通知；放出 count 个元素/空位时最多唤醒 count 个等待者
+    void notify(std::condition_variable &cond, size_t waiters, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (waiters == 0) {
+            ++_wakeupStats.skippedNotifications;
+            return;
+        }
+        if (count >= waiters) {
+            cond.notify_all();
+            _wakeupStats.notifications += waiters;
+            return;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            cond.notify_one();
+        }
+        _wakeupStats.notifications += count;
+    }
+
+    static constexpr size_t kNoBatchThreshold = static_cast<size_t>(-1);
+
+    std::atomic<size_t> _capacity;
+    std::atomic<bool> _isClose;  // 只在锁内写入；锁内读取与不加锁的 IsClosed 共用
+    RingBuffer<T> _queue;
     mutable std::mutex _mtx;
     std::condition_variable _condConsumer;
     std::condition_variable _condProducer;
+    size_t _waitingConsumers = 0;
+    size_t _waitingProducers = 0;
+    std::condition_variable _condBatch;
+    size_t _waitingBatchConsumers = 0;
+    size_t _batchThreshold = kNoBatchThreshold;  // 攒批消费者中最小的 minCount
+    WakeupStats _wakeupStats;
+    std::atomic<size_t> _size{0};
+    std::atomic<WaitStrategy> _waitStrategy;
+    AdaptiveSpin _consumerSpin;
+    AdaptiveSpin _producerSpin;
+    [[no_unique_address]] QueueMetricsRecorder _metrics;  // 未开启统计时不占空间
 };
 
 
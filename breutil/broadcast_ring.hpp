@@ -0,0 +1,406 @@
+#pragma once
+
+/** broadcast_ring.hpp
+ * 单生产者、多订阅者的广播环（Disruptor 式序号环）。
+ * 每个事件只写入环中一次，所有订阅者都能按顺序看到它：订阅者各自记录下一个要读的序号，
+ * 通过 Poll 以 const T& 就地访问 [自己的序号, 已发布序号) 之间的事件，处理完一批只发布一次序号；
+ * 生产者写入序号 s 前要求最慢的订阅者已越过 s - N，否则等待（TryPublish 返回 false）。
+ * 与“每个消费者一个 BlockQueue”相比，事件不复制 N 份，也没有锁。
+ *
+ * 订阅者随时可以加入，从加入时的最新位置开始读；Subscriber 析构即退订，不再拖住生产者。
+ * 没有订阅者时生产者直接覆盖最旧的事件，不会阻塞。
+ * Blocking 为 true 时阻塞接口在短暂自旋后通过 std::atomic::wait 挂起，为 false 时只自旋+yield。
+ * 关闭后 Publish 失败，订阅者读完剩余事件后 Poll 返回 0。
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "spin_wait.hpp"
+
+namespace bre {
+
+template <class T, size_t N, bool Blocking = true>
+class BroadcastRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "BroadcastRing capacity must be a power of two");
+
+    struct Cursor;
+
+public:
+    class Subscriber;
+
+    /**
+     * @param maxSubscribers 同时存在的订阅者上限，每个订阅者的序号独占一个缓存行
+     */
+    explicit BroadcastRing(size_t maxSubscribers = 16)
+        : _slots(new Slot[N]), _cursors(new Cursor[maxSubscribers]), _maxSubscribers(maxSubscribers) {}
+
+    // 订阅者引用着环，析构前应先销毁所有 Subscriber
+    ~BroadcastRing() {
+        for (size_t i = 0; i < N; ++i) {
+            if (_slots[i].live) {
+                std::launder(reinterpret_cast<T *>(_slots[i].storage))->~T();
+            }
+        }
+    }
+
+    // 禁止拷贝和移动
+    BroadcastRing(const BroadcastRing &) = delete;
+    BroadcastRing &operator=(const BroadcastRing &) = delete;
+
+    void Close() {
+        _isClose.store(true, std::memory_order_seq_cst);
+        if constexpr (Blocking) {
+            signal(_consumerSignal);
+            signal(_producerSignal);
+        }
+    }
+
+    bool IsClosed() const { return _isClose.load(std::memory_order_acquire); }
+
+    static constexpr size_t Capacity() { return N; }
+
+    // 已发布的事件总数，即下一个事件的序号
+    uint64_t Published() const { return _published.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 加入订阅，从当前最新位置开始读，之前发布的事件不可见；可在任意线程调用
+     * 订阅者数量达到上限时抛出 std::runtime_error
+     */
+    Subscriber Subscribe() {
+        for (size_t i = 0; i < _maxSubscribers; ++i) {
+            Cursor &cursor = _cursors[i];
+            bool expected = false;
+            if (cursor.claimed.load(std::memory_order_relaxed) ||
+                !cursor.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                continue;
+            }
+            // 先以较旧的位置登记，生产者在此期间只会更保守；再以登记之后的位置开始读。
+            // 与 minSequence 中的 fence 配对：没看到本登记的扫描只会放行覆盖 start 之前的事件
+            cursor.sequence.store(_published.load(std::memory_order_acquire), std::memory_order_relaxed);
+            cursor.active.store(true, std::memory_order_seq_cst);
+            cursor.sequence.store(_published.load(std::memory_order_seq_cst), std::memory_order_release);
+            wakeProducer();
+            return Subscriber(this, &cursor);
+        }
+        throw std::runtime_error("Too many subscribers");
+    }
+
+    // ==================== 生产者接口，只能在一个线程调用 ====================
+
+    // 非阻塞发布，最慢的订阅者落后一整圈或已关闭时返回 false
+    bool TryPublish(const T &item) { return emplace(item); }
+
+    bool TryPublish(T &&item) { return emplace(std::move(item)); }
+
+    template <typename... Args>
+    bool TryEmplace(Args &&...args) {
+        return emplace(std::forward<Args>(args)...);
+    }
+
+    // 阻塞直到最慢的订阅者腾出位置，已关闭时抛出异常
+    void Publish(const T &item) { waitPublish(item); }
+
+    void Publish(T &&item) { waitPublish(std::move(item)); }
+
+    /**
+     * 批量操作：非阻塞地发布尽可能多的元素，只更新一次已发布序号
+     * 构造某个元素抛出异常时，之前构造好的元素照常发布，异常继续向外传递
+     * @return 发布的个数
+     */
+    template <typename InputIt>
+    size_t TryPublish(InputIt first, InputIt last) {
+        if (_isClose.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        const uint64_t next = _published.load(std::memory_order_relaxed);
+        size_t count = 0;
+        try {
+            for (; first != last && claim(next + count); ++first, ++count) {
+                construct(next + count, *first);
+            }
+        } catch (...) {
+            publish(next, count);
+            throw;
+        }
+        publish(next, count);
+        return count;
+    }
+
+    /**
+     * @brief 订阅句柄，只能在一个线程中使用；析构时退订
+     */
+    class Subscriber {
+    public:
+        Subscriber(Subscriber &&other) noexcept
+            : _ring(std::exchange(other._ring, nullptr)), _cursor(std::exchange(other._cursor, nullptr)) {}
+
+        Subscriber &operator=(Subscriber &&other) noexcept {
+            if (this != &other) {
+                Unsubscribe();
+                _ring = std::exchange(other._ring, nullptr);
+                _cursor = std::exchange(other._cursor, nullptr);
+            }
+            return *this;
+        }
+
+        ~Subscriber() { Unsubscribe(); }
+
+        void Unsubscribe() {
+            if (_ring != nullptr) {
+                _ring->release(*_cursor);
+                _ring = nullptr;
+                _cursor = nullptr;
+            }
+        }
+
+        // 下一个要读的事件序号
+        uint64_t Sequence() const { return _cursor->sequence.load(std::memory_order_relaxed); }
+
+        // 已发布但尚未读取的事件数
+        size_t Lag() const { return static_cast<size_t>(_ring->Published() - Sequence()); }
+
+        /**
+         * @brief 以 const T& 依次把已发布的事件交给 handler，不等待；整批处理完才推进序号
+         * handler 抛出异常时已处理的事件视为已读，异常继续向外传递
+         * @return 处理的事件数
+         */
+        template <typename F>
+        size_t TryPoll(F &&handler, size_t maxCount = std::numeric_limits<size_t>::max()) {
+            return _ring->poll(*_cursor, handler, maxCount);
+        }
+
+        /**
+         * @brief 同 TryPoll，没有新事件时阻塞；关闭且读完后返回 0
+         */
+        template <typename F>
+        size_t Poll(F &&handler, size_t maxCount = std::numeric_limits<size_t>::max()) {
+            size_t count = 0;
+            _ring->wait(_ring->_consumerSignal, _ring->_consumersWaiting, [&] {
+                count = _ring->poll(*_cursor, handler, maxCount);
+                return count > 0 || maxCount == 0;
+            });
+            return count;
+        }
+
+    private:
+        friend class BroadcastRing;
+
+        Subscriber(BroadcastRing *ring, Cursor *cursor) : _ring(ring), _cursor(cursor) {}
+
+        BroadcastRing *_ring;
+        Cursor *_cursor;
+    };
+
+private:
+    static constexpr size_t kMask = N - 1;
+    static constexpr int kSpinCount = 128;
+
+    // live 只由生产者（以及析构）读写：构造抛出异常时槽位保持为空，不会被再次析构
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        bool live = false;
+    };
+
+    // 每个订阅者的读序号独占一个缓存行，订阅者推进序号时互不干扰
+    struct alignas(kCacheLineSize) Cursor {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<bool> active{false};
+        std::atomic<bool> claimed{false};
+    };
+
+    T *at(uint64_t seq) { return std::launder(reinterpret_cast<T *>(_slots[seq & kMask].storage)); }
+
+    // 覆盖槽位中上一圈的事件；能走到这里说明所有订阅者都已越过它
+    template <typename... Args>
+    void construct(uint64_t seq, Args &&...args) {
+        Slot &slot = _slots[seq & kMask];
+        if (slot.live) {
+            slot.live = false;
+            at(seq)->~T();
+        }
+        new (slot.storage) T(std::forward<Args>(args)...);
+        slot.live = true;
+    }
+
+    void publish(uint64_t next, size_t count) {
+        if (count > 0) {
+            _published.store(next + count, std::memory_order_release);
+            wakeConsumers();
+        }
+    }
+
+    // 序号 seq 的槽位能否写入；只有按缓存的最慢序号看起来写不下时才重新扫描订阅者
+    bool claim(uint64_t seq) {
+        if (seq - _gatingCache < N) {
+            return true;
+        }
+        _gatingCache = minSequence(seq);
+        return seq - _gatingCache < N;
+    }
+
+    // 所有活跃订阅者中最小的读序号，没有订阅者时为 next
+    uint64_t minSequence(uint64_t next) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t minimum = next;
+        for (size_t i = 0; i < _maxSubscribers; ++i) {
+            const Cursor &cursor = _cursors[i];
+            if (cursor.active.load(std::memory_order_acquire)) {
+                const uint64_t seq = cursor.sequence.load(std::memory_order_acquire);
+                minimum = seq < minimum ? seq : minimum;
+            }
+        }
+        return minimum;
+    }
+
+    template <typename... Args>
+    bool tryEmplace(Args &&...args) {
+        if (_isClose.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        const uint64_t next = _published.load(std::memory_order_relaxed);
+        if (!claim(next)) {
+            return false;
+        }
+        construct(next, std::forward<Args>(args)...);
+        _published.store(next + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename... Args>
+    bool emplace(Args &&...args) {
+        if (!tryEmplace(std::forward<Args>(args)...)) {
+            return false;
+        }
+        wakeConsumers();
+        return true;
+    }
+
+    template <typename U>
+    void waitPublish(U &&item) {
+        bool ok = false;
+        wait(_producerSignal, _producerWaiting, [&] {
+            ok = tryEmplace(std::forward<U>(item));
+            return ok;
+        });
+        if (!ok) {
+            throw std::runtime_error("Queue is closed");
+        }
+        wakeConsumers();
+    }
+
+    template <typename F>
+    size_t poll(Cursor &cursor, F &handler, size_t maxCount) {
+        const uint64_t begin = cursor.sequence.load(std::memory_order_relaxed);
+        const uint64_t available = _published.load(std::memory_order_acquire) - begin;
+        const uint64_t count = available < maxCount ? available : maxCount;
+        uint64_t seq = begin;
+        try {
+            for (; seq < begin + count; ++seq) {
+                handler(static_cast<const T &>(*at(seq)));
+            }
+        } catch (...) {
+            advance(cursor, begin, seq);
+            throw;
+        }
+        advance(cursor, begin, seq);
+        return static_cast<size_t>(count);
+    }
+
+    // release 保证读完槽位之后生产者才能看到新序号并覆盖它
+    void advance(Cursor &cursor, uint64_t begin, uint64_t end) {
+        if (end != begin) {
+            cursor.sequence.store(end, std::memory_order_release);
+            wakeProducer();
+        }
+    }
+
+    void release(Cursor &cursor) {
+        cursor.active.store(false, std::memory_order_release);
+        cursor.claimed.store(false, std::memory_order_release);
+        wakeProducer();
+    }
+
+    /**
+     * 反复执行 op 直到成功或已关闭，关闭后再执行一次 op 以取完剩余事件。
+     * 挂起前先读信号值再登记等待标志，与唤醒一侧的 fence 配对，保证不会丢失唤醒。
+     * 等待标志可能被多个订阅者共用，只由唤醒方清除，醒来的一方不能清除它
+     */
+    template <typename Op>
+    void wait(std::atomic<uint32_t> &sig, std::atomic<bool> &waiting, Op &&op) {
+        for (int i = 0;; ++i) {
+            if (op()) {
+                return;
+            }
+            if (_isClose.load(std::memory_order_acquire)) {
+                op();
+                return;
+            }
+            if (i < kSpinCount) {
+                CpuRelax();
+                continue;
+            }
+            if constexpr (!Blocking) {
+                std::this_thread::yield();
+            } else {
+                const uint32_t observed = sig.load(std::memory_order_acquire);
+                waiting.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (op()) {
+                    return;
+                }
+                if (!_isClose.load(std::memory_order_acquire)) {
+                    sig.wait(observed, std::memory_order_acquire);
+                }
+            }
+        }
+    }
+
+    void wakeConsumers() {
+        if constexpr (Blocking) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_consumersWaiting.load(std::memory_order_relaxed) && _consumersWaiting.exchange(false)) {
+                signal(_consumerSignal);
+            }
+        }
+    }
+
+    void wakeProducer() {
+        if constexpr (Blocking) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_producerWaiting.load(std::memory_order_relaxed) && _producerWaiting.exchange(false)) {
+                signal(_producerSignal);
+            }
+        }
+    }
+
+    static void signal(std::atomic<uint32_t> &sig) {
+        sig.fetch_add(1, std::memory_order_release);
+        sig.notify_all();
+    }
+
+    std::unique_ptr<Slot[]> _slots;
+    std::unique_ptr<Cursor[]> _cursors;
+    const size_t _maxSubscribers;
+
+    // 生产者写的缓存行
+    alignas(kCacheLineSize) std::atomic<uint64_t> _published{0};
+    uint64_t _gatingCache = 0;
+    std::atomic<bool> _consumersWaiting{false};
+    std::atomic<uint32_t> _consumerSignal{0};
+
+    // 订阅者推进序号后检查生产者是否在等待
+    alignas(kCacheLineSize) std::atomic<bool> _producerWaiting{false};
+    std::atomic<uint32_t> _producerSignal{0};
+
+    alignas(kCacheLineSize) std::atomic<bool> _isClose{false};
+};
+
+}  // namespace bre
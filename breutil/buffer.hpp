@@ -1,11 +1,20 @@
 #pragma once
 
-#include <vector>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <stdexcept>
 #include <algorithm>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+#include "simd_scan.hpp"
+
 namespace bre {
 
 
@@ -13,6 +22,26 @@ class Buffer {
 public:
     static constexpr size_t kInitialSize = 1024;
     static constexpr size_t kPrependSize = 8;
+    static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+    /**
+     * @brief 扩容策略
+     * 新容量取 max(所需大小, min(当前容量 * factor, 当前容量 + maxStep))，
+     * 几何增长使连续追加 N 字节的总拷贝量为 O(N)
+     */
+    struct GrowthPolicy {
+        double factor = 2.0;                 // 几何增长因子，<= 1 时按需精确扩容
+        size_t maxStep = 64 * 1024 * 1024;   // 单次扩容最多增加的字节数，0 表示不限制
+        bool hugePageAlign = false;          // 容量达到 kHugePageSize 后向上取整到大页
+    };
+
+    /**
+     * @brief 扩容统计
+     */
+    struct GrowthStats {
+        size_t reallocations = 0;  // 重新分配次数（扩容与 Shrink）
+        size_t bytesCopied = 0;    // 重新分配与数据前移拷贝的字节数
+    };
 
     /**
      * @brief 构造函数
@@ -69,6 +98,31 @@ public:
 
     const char* FindEOL() const;
 
+    /**
+     * @brief 在可读区域查找单字节分隔符
+     * @param delim 分隔符
+     * @return 找到返回指针，否则返回nullptr
+     */
+    const char* FindDelim(char delim) const;
+
+    /**
+     * @brief 在可读区域查找双字节分隔符
+     * @return 找到返回指向 first 的指针，否则返回nullptr
+     */
+    const char* FindDelim(char first, char second) const;
+
+    /**
+     * @brief 增量查找 CRLF，跳过上次调用已确认不含 CRLF 的字节
+     * 一行数据分多次到达时反复调用，总扫描量与数据量成线性关系
+     * @return 找到返回指针，否则返回nullptr
+     */
+    const char* ScanCRLF();
+
+    /**
+     * @brief 增量查找 '\n'，语义同 ScanCRLF
+     */
+    const char* ScanEOL();
+
     /**
      * @brief 取出指定长度的数据
      * @param len 长度
@@ -144,6 +198,32 @@ public:
      */
     size_t Capacity() const;
 
+    void SetGrowthPolicy(const GrowthPolicy& policy);
+
+    const GrowthPolicy& GetGrowthPolicy() const;
+
+    const GrowthStats& GetGrowthStats() const;
+
+#if defined(__unix__) || defined(__APPLE__)
+    /**
+     * @brief 从 fd 读取数据到缓冲区
+     * 可写空间不足 64KB 时借助栈上的额外缓冲区做 readv，一次系统调用即可读空内核缓冲，
+     * 无需预先扩容；超出可写空间的部分再 Append 进来
+     * @param fd 文件描述符
+     * @param savedErrno 出错时保存 errno
+     * @return read 的返回值：读到的字节数，0 表示对端关闭，-1 表示出错
+     */
+    ssize_t ReadFd(int fd, int* savedErrno);
+
+    /**
+     * @brief 把可读数据写入 fd，并取出已写入的部分
+     * @param fd 文件描述符
+     * @param savedErrno 出错时保存 errno
+     * @return write 的返回值：写入的字节数，-1 表示出错
+     */
+    ssize_t WriteFd(int fd, int* savedErrno);
+#endif
+
 private:
     char* begin();
 
@@ -151,9 +231,23 @@ private:
 
     void makeSpace(size_t len);
 
-    std::vector<char> _buffer;   // 缓冲区
+    size_t grownCapacity(size_t required) const;
+
+    void reallocate(size_t capacity);
+
+    void resetScan();
+
+    // 不用 std::vector<char>：它会把新增的每个字节清零，而这些字节马上就会被 read()/Append 覆盖
+    std::unique_ptr<char[]> _buffer;  // 缓冲区，内容未初始化
+    size_t _capacity;             // 缓冲区总字节数
     size_t _readIndex;            // 读索引
     size_t _writeIndex;           // 写索引
+    // 增量查找游标：从 Peek() 起已确认不是分隔符起点的字节数。
+    // 以可读区为基准保存相对偏移，makeSpace 搬移数据和 Shrink 换缓冲区时无需修正，只有 Retrieve 需要扣减
+    size_t _crlfScanned = 0;
+    size_t _eolScanned = 0;
+    GrowthPolicy _policy;
+    GrowthStats _stats;
 };
 
 
@@ -161,7 +255,8 @@ private:
 
 
 inline Buffer::Buffer(size_t initialSize)
-    : _buffer(kPrependSize + initialSize),
+    : _buffer(new char[kPrependSize + initialSize]),
+        _capacity(kPrependSize + initialSize),
         _readIndex(kPrependSize),
         _writeIndex(kPrependSize) {}
 
@@ -169,19 +264,36 @@ inline Buffer::Buffer(size_t initialSize)
 
 inline Buffer::Buffer(Buffer&& other) noexcept
     : _buffer(std::move(other._buffer)),
+        _capacity(other._capacity),
         _readIndex(other._readIndex),
-        _writeIndex(other._writeIndex) {
-    other._readIndex = kPrependSize;
-    other._writeIndex = kPrependSize;
+        _writeIndex(other._writeIndex),
+        _crlfScanned(other._crlfScanned),
+        _eolScanned(other._eolScanned),
+        _policy(other._policy),
+        _stats(other._stats) {
+    // 被移走的对象没有存储，索引归零保证 WritableBytes() 为 0，下一次写入会重新分配
+    other._capacity = 0;
+    other._readIndex = 0;
+    other._writeIndex = 0;
+    other.resetScan();
+    other._stats = GrowthStats{};
 }
 
 inline Buffer& Buffer::operator=(Buffer&& other) noexcept {
     if (this != &other) {
         _buffer = std::move(other._buffer);
+        _capacity = other._capacity;
         _readIndex = other._readIndex;
         _writeIndex = other._writeIndex;
-        other._readIndex = kPrependSize;
-        other._writeIndex = kPrependSize;
+        _crlfScanned = other._crlfScanned;
+        _eolScanned = other._eolScanned;
+        _policy = other._policy;
+        _stats = other._stats;
+        other._capacity = 0;
+        other._readIndex = 0;
+        other._writeIndex = 0;
+        other.resetScan();
+        other._stats = GrowthStats{};
     }
     return *this;
 }
@@ -197,7 +309,7 @@ inline size_t Buffer::ReadableBytes() const {
  * @brief 可写字节数
  */
 inline size_t Buffer::WritableBytes() const {
-    return _buffer.size() - _writeIndex;
+    return _capacity - _writeIndex;
 }
 
 /**
@@ -231,33 +343,43 @@ inline const char* Buffer::BeginWrite() const {
  * @return 找到返回指针，否则返回nullptr
  */
 inline const char* Buffer::FindCRLF() const {
-    const char* start = Peek();
-    const char* end   = BeginWrite();
-    for (const char* p = start; p + 1 < end; ++p) {
-        if (p[0] == '\r' && p[1] == '\n') {
-            return p;
-        }
-    }
-    return nullptr;
+    return simd::FindPair(Peek(), BeginWrite(), '\r', '\n');
 }
 
 inline const char* Buffer::FindCRLF(const char* start) const {
     if (start < Peek() || start >= BeginWrite()) {
         return nullptr;
     }
-    const char* end = BeginWrite();
-    for (const char* p = start; p + 1 < end; ++p) {
-        if (p[0] == '\r' && p[1] == '\n') {
-            return p;
-        }
-    }
-    return nullptr;
+    return simd::FindPair(start, BeginWrite(), '\r', '\n');
 }
 
 inline const char* Buffer::FindEOL() const {
-    std::string_view sv(Peek(), ReadableBytes());
-    const auto pos = sv.find('\n');
-    return pos == std::string_view::npos ? nullptr : (Peek() + pos);
+    return simd::FindChar(Peek(), BeginWrite(), '\n');
+}
+
+inline const char* Buffer::FindDelim(char delim) const {
+    return simd::FindChar(Peek(), BeginWrite(), delim);
+}
+
+inline const char* Buffer::FindDelim(char first, char second) const {
+    return simd::FindPair(Peek(), BeginWrite(), first, second);
+}
+
+inline const char* Buffer::ScanCRLF() {
+    const char* crlf = simd::FindPair(Peek() + _crlfScanned, BeginWrite(), '\r', '\n');
+    if (crlf != nullptr) {
+        _crlfScanned = crlf - Peek();
+    } else if (ReadableBytes() > 0) {
+        // 末尾的 '\r' 可能和下一次到达的 '\n' 组成 CRLF，留到下次重新检查
+        _crlfScanned = ReadableBytes() - 1;
+    }
+    return crlf;
+}
+
+inline const char* Buffer::ScanEOL() {
+    const char* eol = simd::FindChar(Peek() + _eolScanned, BeginWrite(), '\n');
+    _eolScanned = eol != nullptr ? static_cast<size_t>(eol - Peek()) : ReadableBytes();
+    return eol;
 }
 
 /**
@@ -267,6 +389,8 @@ inline const char* Buffer::FindEOL() const {
 inline void Buffer::Retrieve(size_t len) {
     if (len < ReadableBytes()) {
         _readIndex += len;
+        _crlfScanned = _crlfScanned > len ? _crlfScanned - len : 0;
+        _eolScanned = _eolScanned > len ? _eolScanned - len : 0;
     } else {
         RetrieveAll();
     }
@@ -286,8 +410,10 @@ inline void Buffer::RetrieveUntil(const char* end) {
  * @brief 清空所有数据
  */
 inline void Buffer::RetrieveAll() {
-    _readIndex = kPrependSize;
-    _writeIndex = kPrependSize;
+    // 被移走的对象容量为 0，索引保持为 0
+    _readIndex = _capacity > 0 ? kPrependSize : 0;
+    _writeIndex = _readIndex;
+    resetScan();
 }
 
 /**
@@ -369,6 +495,7 @@ inline void Buffer::Prepend(const void* data, size_t len) {
         throw std::length_error("Buffer::Prepend: not enough space");
     }
     _readIndex -= len;
+    resetScan();  // 新插入的字节位于游标之前，尚未扫描
     const char* d = static_cast<const char*>(data);
     std::copy(d, d + len, begin() + _readIndex);
 }
@@ -377,34 +504,45 @@ inline void Buffer::Prepend(const void* data, size_t len) {
  * @brief 收缩缓冲区到合适大小
  */
 inline void Buffer::Shrink(size_t reserve) {
-    std::vector<char> buf(kPrependSize + ReadableBytes() + reserve);
-    const char* start = Peek();
-    const char* end = BeginWrite();
-    std::copy(start, end, buf.begin() + kPrependSize);
-    buf.swap(_buffer);
-    _writeIndex = kPrependSize + ReadableBytes();
-    _readIndex = kPrependSize;
+    reallocate(kPrependSize + ReadableBytes() + reserve);
 }
 
 /**
  * @brief 获取缓冲区总容量
  */
 inline size_t Buffer::Capacity() const {
-    return _buffer.size();
+    return _capacity;
+}
+
+inline void Buffer::SetGrowthPolicy(const GrowthPolicy& policy) {
+    _policy = policy;
+}
+
+inline const Buffer::GrowthPolicy& Buffer::GetGrowthPolicy() const {
+    return _policy;
+}
+
+inline const Buffer::GrowthStats& Buffer::GetGrowthStats() const {
+    return _stats;
 }
 
 inline char* Buffer::begin() {
-    return _buffer.data();
+    return _buffer.get();
 }
 
 inline const char* Buffer::begin() const {
-    return _buffer.data();
+    return _buffer.get();
+}
+
+inline void Buffer::resetScan() {
+    _crlfScanned = 0;
+    _eolScanned = 0;
 }
 
 inline void Buffer::makeSpace(size_t len) {
     if (WritableBytes() + PrependableBytes() < len + kPrependSize) {
         // 需要扩容
-        _buffer.resize(_writeIndex + len);
+        reallocate(grownCapacity(kPrependSize + ReadableBytes() + len));
     } else {
         // 移动数据到前面
         size_t readable = ReadableBytes();
@@ -413,8 +551,72 @@ inline void Buffer::makeSpace(size_t len) {
                     begin() + kPrependSize);
         _readIndex = kPrependSize;
         _writeIndex = _readIndex + readable;
+        _stats.bytesCopied += readable;
+    }
+}
+
+inline size_t Buffer::grownCapacity(size_t required) const {
+    size_t capacity = required;
+    if (_policy.factor > 1.0) {
+        auto grown = static_cast<size_t>(static_cast<double>(_capacity) * _policy.factor);
+        if (_policy.maxStep > 0 && grown > _capacity + _policy.maxStep) {
+            grown = _capacity + _policy.maxStep;
+        }
+        capacity = std::max(capacity, grown);
+    }
+    if (_policy.hugePageAlign && capacity >= kHugePageSize) {
+        capacity = (capacity + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    }
+    return capacity;
+}
+
+// 换到一块新的未初始化内存，只拷贝可读数据，读索引回到 kPrependSize
+inline void Buffer::reallocate(size_t capacity) {
+    const size_t readable = ReadableBytes();
+    std::unique_ptr<char[]> buf(new char[capacity]);
+    if (readable > 0) {
+        std::copy(Peek(), Peek() + readable, buf.get() + kPrependSize);
+    }
+    _buffer = std::move(buf);
+    _capacity = capacity;
+    _stats.reallocations += 1;
+    _stats.bytesCopied += readable;
+    _readIndex = kPrependSize;
+    _writeIndex = kPrependSize + readable;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+inline ssize_t Buffer::ReadFd(int fd, int* savedErrno) {
+    char extrabuf[65536];
+    struct iovec vec[2];
+    const size_t writable = WritableBytes();
+    vec[0].iov_base = BeginWrite();
+    vec[0].iov_len = writable;
+    vec[1].iov_base = extrabuf;
+    vec[1].iov_len = sizeof(extrabuf);
+    const int iovcnt = writable < sizeof(extrabuf) ? 2 : 1;
+    const ssize_t n = ::readv(fd, vec, iovcnt);
+    if (n < 0) {
+        *savedErrno = errno;
+    } else if (static_cast<size_t>(n) <= writable) {
+        _writeIndex += n;
+    } else {
+        _writeIndex = _capacity;
+        Append(extrabuf, n - writable);
+    }
+    return n;
+}
+
+inline ssize_t Buffer::WriteFd(int fd, int* savedErrno) {
+    const ssize_t n = ::write(fd, Peek(), ReadableBytes());
+    if (n < 0) {
+        *savedErrno = errno;
+    } else {
+        Retrieve(n);
     }
+    return n;
 }
+#endif
 
 
 #pragma endregion inline functions
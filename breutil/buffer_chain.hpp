@@ -0,0 +1,458 @@
+#pragma once
+
+/** buffer_chain.hpp
+ * 由固定大小数据块串成的缓冲区。
+ * 与 Buffer 不同，追加数据只会在尾部挂新块，不会整体扩容或前移数据；
+ * 块从 BlockPool 获取、用完归还，Splice 可以把一条链整体接到另一条链后面而不拷贝数据。
+ * 接口尽量与 Buffer 保持一致，便于替换。
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace bre {
+
+/**
+ * @brief 固定大小数据块的对象池，线程安全，可被多个 BufferChain 共享
+ */
+class BlockPool {
+public:
+    static constexpr size_t kDefaultBlockSize = 4096;
+    static constexpr size_t kDefaultMaxCached = 1024;
+
+    struct Block {
+        Block* next = nullptr;
+        size_t readIndex = 0;
+        size_t writeIndex = 0;
+        size_t size = 0;  // 数据区字节数
+
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+        const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+        size_t ReadableBytes() const { return writeIndex - readIndex; }
+        size_t WritableBytes() const { return size - writeIndex; }
+    };
+
+    /**
+     * @brief 构造函数
+     * @param blockSize 每个块的数据区大小
+     * @param maxCached 空闲链表最多缓存的块数，超出的块直接释放
+     */
+    explicit BlockPool(size_t blockSize = kDefaultBlockSize, size_t maxCached = kDefaultMaxCached)
+        : _blockSize(blockSize), _maxCached(maxCached) {}
+
+    ~BlockPool() {
+        while (_free != nullptr) {
+            Block* block = _free;
+            _free = block->next;
+            deallocate(block);
+        }
+    }
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    /**
+     * @brief 进程级默认池
+     */
+    static const std::shared_ptr<BlockPool>& Default() {
+        static const std::shared_ptr<BlockPool> pool = std::make_shared<BlockPool>();
+        return pool;
+    }
+
+    /**
+     * @brief 取一个空块
+     */
+    Block* Acquire() {
+        {
+            std::lock_guard<std::mutex> locker(_mtx);
+            if (_free != nullptr) {
+                Block* block = _free;
+                _free = block->next;
+                --_cached;
+                block->next = nullptr;
+                block->readIndex = 0;
+                block->writeIndex = 0;
+                return block;
+            }
+        }
+        return allocate(_blockSize);
+    }
+
+    /**
+     * @brief 归还一个块；大小与本池不同（来自别的池）或缓存已满时直接释放
+     */
+    void Release(Block* block) {
+        if (block->size == _blockSize) {
+            std::lock_guard<std::mutex> locker(_mtx);
+            if (_cached < _maxCached) {
+                block->next = _free;
+                _free = block;
+                ++_cached;
+                return;
+            }
+        }
+        deallocate(block);
+    }
+
+    size_t BlockSize() const { return _blockSize; }
+
+    size_t CachedBlocks() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _cached;
+    }
+
+private:
+    static Block* allocate(size_t size) {
+        void* mem = ::operator new(sizeof(Block) + size);
+        Block* block = new (mem) Block();
+        block->size = size;
+        return block;
+    }
+
+    static void deallocate(Block* block) {
+        block->~Block();
+        ::operator delete(block);
+    }
+
+    size_t _blockSize;
+    size_t _maxCached;
+    mutable std::mutex _mtx;
+    Block* _free = nullptr;  // 空闲链表
+    size_t _cached = 0;
+};
+
+
+class BufferChain {
+public:
+    using Block = BlockPool::Block;
+
+    explicit BufferChain(std::shared_ptr<BlockPool> pool = BlockPool::Default());
+
+    ~BufferChain();
+
+    // 禁止拷贝
+    BufferChain(const BufferChain&) = delete;
+    BufferChain& operator=(const BufferChain&) = delete;
+
+    // 支持移动
+    BufferChain(BufferChain&& other) noexcept;
+
+    BufferChain& operator=(BufferChain&& other) noexcept;
+
+    /**
+     * @brief 可读字节数
+     */
+    size_t ReadableBytes() const;
+
+    /**
+     * @brief 当前持有的块数
+     */
+    size_t BlockCount() const;
+
+    /**
+     * @brief 追加数据，尾块写满后从池中取新块
+     * @param data 数据指针
+     * @param len 数据长度
+     */
+    void Append(const char* data, size_t len);
+
+    void Append(std::string_view str);
+
+    /**
+     * @brief 取出指定长度的数据，读空的块归还给池
+     * @param len 长度，超过可读字节数时清空
+     */
+    void Retrieve(size_t len);
+
+    /**
+     * @brief 清空所有数据
+     */
+    void RetrieveAll();
+
+    /**
+     * @brief 取出指定长度的数据作为字符串
+     */
+    std::string RetrieveAsString(size_t len);
+
+    /**
+     * @brief 取出所有数据作为字符串
+     */
+    std::string RetrieveAllAsString();
+
+    /**
+     * @brief 转换为字符串（用于调试）
+     */
+    std::string ToString() const;
+
+    /**
+     * @brief 把 other 的全部块接到本链尾部，不拷贝数据，other 变为空
+     */
+    void Splice(BufferChain& other);
+
+#if defined(__unix__) || defined(__APPLE__)
+    /**
+     * @brief 以 iovec 形式查看可读数据，不取出
+     * @param iov 输出数组
+     * @param maxIov 数组长度
+     * @return 填充的 iovec 个数
+     */
+    size_t PeekIov(struct iovec* iov, size_t maxIov) const;
+
+    /**
+     * @brief 用 writev 把可读数据写入 fd，并取出已写入的部分
+     * @return writev 的返回值，-1 表示出错并保存 errno
+     */
+    ssize_t WriteFd(int fd, int* savedErrno);
+
+    /**
+     * @brief 从 fd 读取数据，语义同 Buffer::ReadFd
+     * 先填满尾块剩余空间，其余经由 64KB 栈上缓冲区追加到新块
+     */
+    ssize_t ReadFd(int fd, int* savedErrno);
+#endif
+
+private:
+    static constexpr size_t kMaxIov = 64;
+
+    void releaseAll();
+
+    std::shared_ptr<BlockPool> _pool;
+    Block* _head = nullptr;
+    Block* _tail = nullptr;
+    size_t _readable = 0;
+    size_t _blocks = 0;
+};
+
+
+#pragma region inline functions
+
+inline BufferChain::BufferChain(std::shared_ptr<BlockPool> pool) : _pool(std::move(pool)) {}
+
+inline BufferChain::~BufferChain() {
+    releaseAll();
+}
+
+inline BufferChain::BufferChain(BufferChain&& other) noexcept
+    : _pool(other._pool), _head(other._head), _tail(other._tail), _readable(other._readable), _blocks(other._blocks) {
+    // 保留 other 的池，使其移动后仍可继续使用
+    other._head = nullptr;
+    other._tail = nullptr;
+    other._readable = 0;
+    other._blocks = 0;
+}
+
+inline BufferChain& BufferChain::operator=(BufferChain&& other) noexcept {
+    if (this != &other) {
+        releaseAll();
+        _pool = other._pool;
+        _head = other._head;
+        _tail = other._tail;
+        _readable = other._readable;
+        _blocks = other._blocks;
+        other._head = nullptr;
+        other._tail = nullptr;
+        other._readable = 0;
+        other._blocks = 0;
+    }
+    return *this;
+}
+
+inline size_t BufferChain::ReadableBytes() const {
+    return _readable;
+}
+
+inline size_t BufferChain::BlockCount() const {
+    return _blocks;
+}
+
+inline void BufferChain::Append(const char* data, size_t len) {
+    while (len > 0) {
+        if (_tail == nullptr || _tail->WritableBytes() == 0) {
+            Block* block = _pool->Acquire();
+            if (_tail == nullptr) {
+                _head = block;
+            } else {
+                _tail->next = block;
+            }
+            _tail = block;
+            ++_blocks;
+        }
+        const size_t n = std::min(len, _tail->WritableBytes());
+        std::copy(data, data + n, _tail->data() + _tail->writeIndex);
+        _tail->writeIndex += n;
+        _readable += n;
+        data += n;
+        len -= n;
+    }
+}
+
+inline void BufferChain::Append(std::string_view str) {
+    Append(str.data(), str.size());
+}
+
+inline void BufferChain::Retrieve(size_t len) {
+    if (len >= _readable) {
+        RetrieveAll();
+        return;
+    }
+    _readable -= len;
+    while (len > 0) {
+        const size_t n = std::min(len, _head->ReadableBytes());
+        _head->readIndex += n;
+        len -= n;
+        if (_head->ReadableBytes() == 0) {
+            Block* block = _head;
+            _head = block->next;
+            _pool->Release(block);
+            --_blocks;
+        }
+    }
+}
+
+inline void BufferChain::RetrieveAll() {
+    // 保留最后一个块，避免追加/取出交替时反复向池申请
+    while (_head != _tail) {
+        Block* block = _head;
+        _head = block->next;
+        _pool->Release(block);
+        --_blocks;
+    }
+    if (_head != nullptr) {
+        _head->readIndex = 0;
+        _head->writeIndex = 0;
+    }
+    _readable = 0;
+}
+
+inline std::string BufferChain::RetrieveAsString(size_t len) {
+    len = std::min(len, _readable);
+    std::string result;
+    result.reserve(len);
+    size_t remain = len;
+    for (const Block* block = _head; block != nullptr && remain > 0; block = block->next) {
+        const size_t n = std::min(remain, block->ReadableBytes());
+        result.append(block->data() + block->readIndex, n);
+        remain -= n;
+    }
+    Retrieve(len);
+    return result;
+}
+
+inline std::string BufferChain::RetrieveAllAsString() {
+    return RetrieveAsString(_readable);
+}
+
+inline std::string BufferChain::ToString() const {
+    std::string result;
+    result.reserve(_readable);
+    for (const Block* block = _head; block != nullptr; block = block->next) {
+        result.append(block->data() + block->readIndex, block->ReadableBytes());
+    }
+    return result;
+}
+
+inline void BufferChain::Splice(BufferChain& other) {
+    if (this == &other || other._head == nullptr) {
+        return;
+    }
+    if (_tail == nullptr) {
+        _head = other._head;
+    } else {
+        _tail->next = other._head;
+    }
+    _tail = other._tail;
+    _readable += other._readable;
+    _blocks += other._blocks;
+    other._head = nullptr;
+    other._tail = nullptr;
+    other._readable = 0;
+    other._blocks = 0;
+}
+
+inline void BufferChain::releaseAll() {
+    while (_head != nullptr) {
+        Block* block = _head;
+        _head = block->next;
+        _pool->Release(block);
+    }
+    _tail = nullptr;
+    _readable = 0;
+    _blocks = 0;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+inline size_t BufferChain::PeekIov(struct iovec* iov, size_t maxIov) const {
+    size_t count = 0;
+    for (const Block* block = _head; block != nullptr && count < maxIov; block = block->next) {
+        if (block->ReadableBytes() == 0) {
+            continue;
+        }
+        iov[count].iov_base = const_cast<char*>(block->data() + block->readIndex);
+        iov[count].iov_len = block->ReadableBytes();
+        ++count;
+    }
+    return count;
+}
+
+inline ssize_t BufferChain::WriteFd(int fd, int* savedErrno) {
+    struct iovec iov[kMaxIov];
+    const size_t count = PeekIov(iov, kMaxIov);
+    const ssize_t n = ::writev(fd, iov, static_cast<int>(count));
+    if (n < 0) {
+        *savedErrno = errno;
+    } else {
+        Retrieve(n);
+    }
+    return n;
+}
+
+inline ssize_t BufferChain::ReadFd(int fd, int* savedErrno) {
+    char extrabuf[65536];
+    struct iovec vec[2];
+    const size_t writable = _tail != nullptr ? _tail->WritableBytes() : 0;
+    int iovcnt = 0;
+    if (writable > 0) {
+        vec[iovcnt].iov_base = _tail->data() + _tail->writeIndex;
+        vec[iovcnt].iov_len = writable;
+        ++iovcnt;
+    }
+    vec[iovcnt].iov_base = extrabuf;
+    vec[iovcnt].iov_len = sizeof(extrabuf);
+    ++iovcnt;
+    const ssize_t n = ::readv(fd, vec, iovcnt);
+    if (n <= 0) {
+        // 出错或对端关闭：空链此时还没有尾块，不能碰 _tail
+        if (n < 0) {
+            *savedErrno = errno;
+        }
+        return n;
+    }
+    if (static_cast<size_t>(n) <= writable) {
+        _tail->writeIndex += n;
+        _readable += n;
+    } else {
+        if (writable > 0) {
+            _tail->writeIndex += writable;
+            _readable += writable;
+        }
+        Append(extrabuf, n - writable);
+    }
+    return n;
+}
+#endif
+
+#pragma endregion inline functions
+
+}  // namespace bre
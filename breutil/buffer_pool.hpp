@@ -0,0 +1,204 @@
+#pragma once
+
+/** buffer_pool.hpp
+ * Buffer 对象池：按容量分级缓存用完的 Buffer，保留其已分配的内存。
+ * 每个线程一个池（BufferPool::Local()），获取与归还都不加锁；
+ * 连接反复建立与关闭时，稳态下获取 Buffer 不再触发堆分配。
+ */
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "buffer.hpp"
+
+namespace bre {
+
+class BufferPool {
+public:
+    // 各级可写容量，相邻两级相差 4 倍
+    static constexpr size_t kClassCount = 6;
+    static constexpr std::array<size_t, kClassCount> kClassSizes = {
+        1024, 4 * 1024, 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024,
+    };
+    static constexpr size_t kMaxCachedPerClass = 64;
+
+    struct Stats {
+        size_t hits = 0;             // 从缓存取到
+        size_t misses = 0;           // 新建
+        size_t returned = 0;         // 归还后进入缓存
+        size_t dropped = 0;          // 归还时因缓存已满或容量不合适而释放
+        size_t retainedBuffers = 0;  // 当前缓存的 Buffer 数
+        size_t retainedBytes = 0;    // 当前缓存的 Buffer 容量之和
+
+        double HitRate() const {
+            const size_t total = hits + misses;
+            return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+        }
+    };
+
+    /**
+     * @brief 持有一个池化 Buffer 的 RAII 句柄，析构时归还给当前线程的池
+     * 当前线程的池已经析构（例如句柄本身是另一个更晚析构的 thread_local）时直接释放
+     */
+    class Handle {
+    public:
+        Handle() = default;
+
+        ~Handle() { Release(); }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        Handle(Handle&& other) noexcept : _buffer(other._buffer) { other._buffer = nullptr; }
+
+        Handle& operator=(Handle&& other) noexcept {
+            if (this != &other) {
+                Release();
+                _buffer = other._buffer;
+                other._buffer = nullptr;
+            }
+            return *this;
+        }
+
+        Buffer* Get() const { return _buffer; }
+        Buffer* operator->() const { return _buffer; }
+        Buffer& operator*() const { return *_buffer; }
+        explicit operator bool() const { return _buffer != nullptr; }
+
+        /**
+         * @brief 提前归还；归还到调用线程的池，跨线程传递的句柄不会访问原线程的缓存
+         */
+        void Release() {
+            if (_buffer != nullptr) {
+                if (BufferPool::localDestroyed()) {
+                    delete _buffer;
+                } else {
+                    BufferPool::Local().release(_buffer);
+                }
+                _buffer = nullptr;
+            }
+        }
+
+    private:
+        friend class BufferPool;
+
+        explicit Handle(Buffer* buffer) : _buffer(buffer) {}
+
+        Buffer* _buffer = nullptr;
+    };
+
+    ~BufferPool() {
+        Trim();
+        localDestroyed() = true;
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief 当前线程的池，也是唯一的池：Handle 总是归还到调用线程的池，不能单独构造
+     * 线程退出时池随 thread_local 析构，之后归还的 Handle 直接释放，但不能再 Acquire
+     */
+    static BufferPool& Local() {
+        thread_local BufferPool pool;
+        return pool;
+    }
+
+    /**
+     * @brief 获取一个空 Buffer，可写空间不少于 minWritable
+     * 超过最大级别的请求不走缓存，直接新建
+     */
+    Handle Acquire(size_t minWritable = Buffer::kInitialSize) {
+        for (size_t i = 0; i < kClassCount; ++i) {
+            if (kClassSizes[i] < minWritable) {
+                continue;
+            }
+            if (!_free[i].empty()) {
+                Buffer* buffer = _free[i].back();
+                _free[i].pop_back();
+                _retainedBytes -= buffer->Capacity();
+                ++_hits;
+                return Handle(buffer);
+            }
+            ++_misses;
+            return Handle(new Buffer(kClassSizes[i]));
+        }
+        ++_misses;
+        return Handle(new Buffer(minWritable));
+    }
+
+    /**
+     * @brief 释放所有缓存的 Buffer
+     */
+    void Trim() {
+        for (auto& list : _free) {
+            for (Buffer* buffer : list) {
+                delete buffer;
+            }
+            list.clear();
+        }
+        _retainedBytes = 0;
+    }
+
+    Stats GetStats() const {
+        Stats stats;
+        stats.hits = _hits;
+        stats.misses = _misses;
+        stats.returned = _returned;
+        stats.dropped = _dropped;
+        for (const auto& list : _free) {
+            stats.retainedBuffers += list.size();
+        }
+        stats.retainedBytes = _retainedBytes;
+        return stats;
+    }
+
+private:
+    BufferPool() {
+        for (auto& list : _free) {
+            list.reserve(kMaxCachedPerClass);
+        }
+    }
+
+    // 平凡析构的 thread_local，池析构之后仍可读取
+    static bool& localDestroyed() {
+        thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    // 按可写容量向下取级：保证取出的 Buffer 满足该级大小；过大的 Buffer 不缓存，避免长期占用内存
+    static int classOf(size_t writable) {
+        for (size_t i = kClassCount; i-- > 0;) {
+            if (writable >= kClassSizes[i]) {
+                return writable < kClassSizes[i] * 4 ? static_cast<int>(i) : -1;
+            }
+        }
+        return -1;
+    }
+
+    void release(Buffer* buffer) {
+        buffer->RetrieveAll();
+        // 被移走内容的 Buffer 容量为 0，按不可缓存处理
+        const size_t writable = buffer->Capacity() > Buffer::kPrependSize ? buffer->Capacity() - Buffer::kPrependSize : 0;
+        const int cls = classOf(writable);
+        if (cls < 0 || _free[cls].size() >= kMaxCachedPerClass) {
+            ++_dropped;
+            delete buffer;
+            return;
+        }
+        buffer->SetGrowthPolicy(Buffer::GrowthPolicy{});
+        _free[cls].push_back(buffer);
+        _retainedBytes += buffer->Capacity();
+        ++_returned;
+    }
+
+    std::array<std::vector<Buffer*>, kClassCount> _free;
+    size_t _retainedBytes = 0;
+    size_t _hits = 0;
+    size_t _misses = 0;
+    size_t _returned = 0;
+    size_t _dropped = 0;
+};
+
+}  // namespace bre
@@ -0,0 +1,95 @@
+#pragma once
+
+/** epoch_reclaim.hpp
+ * 无锁结构的基于纪元的内存回收（epoch-based reclamation）。
+ * 访问共享节点前 Pin() 进入当前纪元，Guard 析构时退出；摘下的节点按摘下时的全局纪元分组退役。
+ * 只有当前纪元的前一个纪元中已没有线程时才能推进纪元，因此推进到 e 之后，
+ * 在 e-2 及更早退役的节点不会再被任何线程持有，可以回收或复用。
+ * 各纪元的在场线程数按条带计数，线程固定落在某一条带上，进出纪元只触碰自己条带的缓存行。
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "spin_wait.hpp"
+
+namespace bre {
+
+class EpochDomain {
+public:
+    static constexpr size_t kStripes = 8;
+
+    class Guard {
+    public:
+        explicit Guard(EpochDomain &domain) : _counter(&domain.enter(_epoch)) {}
+
+        ~Guard() { _counter->fetch_sub(1, std::memory_order_release); }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+        // 进入时的纪元
+        uint64_t Epoch() const { return _epoch; }
+
+    private:
+        uint64_t _epoch = 0;
+        std::atomic<uint64_t> *_counter;
+    };
+
+    // 进入当前纪元，返回的 Guard 存活期间读到的共享节点不会被回收
+    [[nodiscard]] Guard Pin() { return Guard(*this); }
+
+    uint64_t Current() const { return _epoch.load(std::memory_order_seq_cst); }
+
+    /**
+     * @brief 前一个纪元中已没有线程时把纪元加一
+     * 需在 Guard 存活期间调用：成功后直到本线程退出之前纪元不会再推进，
+     * 调用方可以放心回收 newEpoch - 2 纪元退役的节点
+     * @return 是否由本线程推进成功
+     */
+    bool TryAdvance(uint64_t &newEpoch) {
+        uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+        for (const auto &stripe : _stripes[(epoch + 2) % 3]) {
+            if (stripe.count.load(std::memory_order_seq_cst) != 0) {
+                return false;
+            }
+        }
+        if (!_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst)) {
+            return false;
+        }
+        newEpoch = epoch + 1;
+        return true;
+    }
+
+private:
+    struct alignas(kCacheLineSize) Stripe {
+        std::atomic<uint64_t> count{0};
+    };
+
+    // 登记后再确认纪元没变：推进方检查计数时若没看到本次登记，这里一定能读到新纪元而重试
+    std::atomic<uint64_t> &enter(uint64_t &epoch) {
+        const size_t stripe = stripeIndex();
+        for (;;) {
+            epoch = _epoch.load(std::memory_order_seq_cst);
+            std::atomic<uint64_t> &counter = _stripes[epoch % 3][stripe].count;
+            counter.fetch_add(1, std::memory_order_seq_cst);
+            if (_epoch.load(std::memory_order_seq_cst) == epoch) {
+                return counter;
+            }
+            counter.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    static size_t stripeIndex() {
+        static std::atomic<size_t> next{0};
+        thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed) % kStripes;
+        return index;
+    }
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> _epoch{0};
+    std::array<Stripe, kStripes> _stripes[3];
+};
+
+}  // namespace bre
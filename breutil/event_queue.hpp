@@ -0,0 +1,229 @@
+#pragma once
+
+/** event_queue.hpp
+ * 可以注册到 epoll 的有界队列（仅 Linux）。
+ * 队列的“非空”状态由一个 eventfd 表示：队列从空变为非空时写一次 eventfd，
+ * 事件循环线程在 epoll 报告 Fd() 可读后调用 TryPopAll，一次加锁取走全部元素并清除 eventfd 的计数。
+ * 跨线程投递到事件循环时，每一批元素只需一次 write 和一次 read，而不是每个元素一次。
+ * 生产者在队列满时可以阻塞（Push）或直接失败（TryPush）；消费者从不阻塞。
+ */
+
+#ifdef __linux__
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include "ring_buffer.hpp"
+
+namespace bre {
+
+template <class T>
+class EventQueue {
+public:
+    /**
+     * @throw std::system_error 创建 eventfd 失败
+     */
+    explicit EventQueue(size_t MaxCapacity = 1024)
+        : _capacity(MaxCapacity), _queue(MaxCapacity), _fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        if (_fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "eventfd");
+        }
+    }
+
+    ~EventQueue() {
+        Close();
+        ::close(_fd);
+    }
+
+    // 禁止拷贝和移动，描述符可能已注册到 epoll
+    EventQueue(const EventQueue &) = delete;
+    EventQueue &operator=(const EventQueue &) = delete;
+
+    /**
+     * @brief 以 EPOLLIN 注册到 epoll；队列非空或已关闭时可读（电平触发）
+     * 描述符归队列所有，不要自行读写或关闭
+     */
+    int Fd() const { return _fd; }
+
+    // 关闭后 Fd() 保持可读，事件循环据此发现关闭；剩余元素仍可取出
+    void Close() {
+        {
+            std::lock_guard<std::mutex> locker(_mtx);
+            _isClose = true;
+            signalLocked();
+        }
+        _condProducer.notify_all();
+    }
+
+    bool IsClosed() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _isClose;
+    }
+
+    size_t Size() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _queue.Size();
+    }
+
+    bool Empty() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _queue.Empty();
+    }
+
+    bool Full() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _queue.Size() >= _capacity;
+    }
+
+    size_t Capacity() const { return _capacity; }
+
+    // 非阻塞 Push，如果队列满或已关闭则返回 false
+    bool TryPush(const T &item) {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return tryPushLocked(item);
+    }
+
+    bool TryPush(T &&item) {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return tryPushLocked(std::move(item));
+    }
+
+    /**
+     * @brief 非阻塞批量 Push，放入尽可能多的元素，整批至多写一次 eventfd
+     * @return 成功放入的元素个数，从 first 开始连续计数
+     */
+    template <typename ForwardIt>
+    size_t TryPush(ForwardIt first, ForwardIt last) {
+        std::lock_guard<std::mutex> locker(_mtx);
+        if (_isClose) {
+            return 0;
+        }
+        size_t count = 0;
+        for (; first != last && _queue.Size() < _capacity; ++first, ++count) {
+            _queue.EmplaceBack(*first);
+        }
+        if (count > 0) {
+            signalLocked();
+        }
+        return count;
+    }
+
+    // 队列满时阻塞直到事件循环取走元素
+    void Push(const T &item) { waitPush(item); }
+
+    void Push(T &&item) { waitPush(std::move(item)); }
+
+    // 取出一个元素；取空时清除 eventfd 的计数
+    std::optional<T> TryPop() {
+        std::optional<T> item;
+        size_t waiting = 0;
+        {
+            std::lock_guard<std::mutex> locker(_mtx);
+            if (_queue.Empty()) {
+                return item;
+            }
+            item.emplace(std::move(_queue.Front()));
+            _queue.PopFront();
+            clearLocked();
+            waiting = _waitingProducers;
+        }
+        if (waiting > 0) {
+            _condProducer.notify_one();
+        }
+        return item;
+    }
+
+    /**
+     * @brief 一次加锁取走全部元素，并清除 eventfd 的计数，通常在 epoll 报告 Fd() 可读后调用
+     * @return 取出的元素个数
+     */
+    template <typename OutputIt>
+    size_t TryPopAll(OutputIt dest) {
+        size_t count = 0;
+        size_t waiting = 0;
+        {
+            std::lock_guard<std::mutex> locker(_mtx);
+            count = _queue.Size();
+            for (; !_queue.Empty(); _queue.PopFront()) {
+                *dest++ = std::move(_queue.Front());
+            }
+            clearLocked();
+            waiting = _waitingProducers;
+        }
+        // 等待计数在锁内读取：为 0 时之后才挂起的生产者会在锁内看到空位，不会错过唤醒
+        if (waiting > 0 && count > 0) {
+            _condProducer.notify_all();
+        }
+        return count;
+    }
+
+private:
+    // 仅在空到非空的转换时写 eventfd；写入与读取都在锁内，计数与 _signaled 始终一致
+    void signalLocked() {
+        if (_signaled) {
+            return;
+        }
+        _signaled = true;
+        const uint64_t one = 1;
+        while (::write(_fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+        }
+    }
+
+    // 队列已空且未关闭时读走计数，Fd() 不再可读
+    void clearLocked() {
+        if (!_signaled || !_queue.Empty() || _isClose) {
+            return;
+        }
+        _signaled = false;
+        uint64_t value = 0;
+        while (::read(_fd, &value, sizeof(value)) < 0 && errno == EINTR) {
+        }
+    }
+
+    template <typename U>
+    bool tryPushLocked(U &&item) {
+        if (_isClose || _queue.Size() >= _capacity) {
+            return false;
+        }
+        _queue.EmplaceBack(std::forward<U>(item));
+        signalLocked();
+        return true;
+    }
+
+    template <typename U>
+    void waitPush(U &&item) {
+        std::unique_lock<std::mutex> locker(_mtx);
+        if (_queue.Size() >= _capacity && !_isClose) {
+            ++_waitingProducers;
+            _condProducer.wait(locker, [this] {
+                return _isClose || _queue.Size() < _capacity;
+            });
+            --_waitingProducers;
+        }
+        if (!tryPushLocked(std::forward<U>(item))) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    const size_t _capacity;
+    bool _isClose = false;
+    bool _signaled = false;  // eventfd 计数是否非零
+    RingBuffer<T> _queue;
+    const int _fd;
+    mutable std::mutex _mtx;
+    std::condition_variable _condProducer;
+    size_t _waitingProducers = 0;
+};
+
+}  // namespace bre
+
+#endif  // __linux__
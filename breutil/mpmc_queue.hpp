@@ -0,0 +1,248 @@
+#pragma once
+
+/** mpmc_queue.hpp
+ * 有界多生产者多消费者无锁队列（Dmitry Vyukov 的环形数组算法）。
+ * 每个槽位带一个序号，生产者与消费者各自只竞争一个位置计数器，Push/Pop 无需互斥锁；
+ * 只有在队列满/空需要阻塞等待时才进入条件变量。
+ * 接口与 BlockQueue 保持一致：TryPush/TryPop、带超时的阻塞 Push/Pop、Close。
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "spin_wait.hpp"
+
+namespace bre {
+
+template <class T>
+class MpmcQueue {
+public:
+    /**
+     * @param MaxCapacity 容量，向上取整到 2 的幂
+     */
+    explicit MpmcQueue(size_t MaxCapacity = 1024)
+        : _mask(roundUpPowerOfTwo(MaxCapacity) - 1), _cells(new Cell[_mask + 1]) {
+        for (size_t i = 0; i <= _mask; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcQueue() {
+        Close();
+        while (tryPop([](T &&) {})) {
+        }
+    }
+
+    // 禁止拷贝和移动
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    /**
+     * 关闭队列：之后的 Push 失败，Pop 取完剩余元素后返回 false。
+     * 与 Close 并发进行的 Push 仍可能成功入队
+     */
+    void Close() {
+        _isClose.store(true, std::memory_order_seq_cst);
+        _producers.WakeAll();
+        _consumers.WakeAll();
+    }
+
+    bool IsClosed() const { return _isClose.load(std::memory_order_acquire); }
+
+    // 以下观测接口为无锁的近似快照
+    size_t Size() const {
+        const size_t deq = _dequeuePos.load(std::memory_order_relaxed);
+        const size_t enq = _enqueuePos.load(std::memory_order_relaxed);
+        const size_t size = enq > deq ? enq - deq : 0;
+        return size > Capacity() ? Capacity() : size;
+    }
+
+    bool Empty() const { return Size() == 0; }
+
+    bool Full() const { return Size() >= Capacity(); }
+
+    size_t Capacity() const { return _mask + 1; }
+
+    // 非阻塞 Push，如果队列满或已关闭则返回 false
+    bool TryPush(const T &item) { return tryPushNotify(item); }
+
+    bool TryPush(T &&item) { return tryPushNotify(std::move(item)); }
+
+    void Push(const T &item) {
+        if (!waitPush(item, std::nullopt)) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    void Push(T &&item) {
+        if (!waitPush(std::move(item), std::nullopt)) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    // 支持超时的 Push
+    template <typename Rep, typename Period>
+    bool Push(const T &item, const std::chrono::duration<Rep, Period> &timeout) {
+        return waitPush(item, DeadlineAfter(timeout));
+    }
+
+    template <typename Rep, typename Period>
+    bool Push(T &&item, const std::chrono::duration<Rep, Period> &timeout) {
+        return waitPush(std::move(item), DeadlineAfter(timeout));
+    }
+
+    // 非阻塞
+    std::optional<T> TryPop() {
+        std::optional<T> item;
+        tryPopNotify([&item](T &&value) {
+            item.emplace(std::move(value));
+        });
+        return item;
+    }
+
+    // 从队列拿走一个元素，队列关闭且为空时返回 false
+    bool Pop(T &item) { return waitPop(item, std::nullopt); }
+
+    bool Pop(T &item, int timeout_ms) {
+        return waitPop(item, DeadlineAfter(std::chrono::milliseconds(timeout_ms)));
+    }
+
+private:
+    using Deadline = Parker::Deadline;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static size_t roundUpPowerOfTwo(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    template <typename U>
+    bool tryPush(U &&item) {
+        if (_isClose.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        Cell *cell;
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false;  // 满
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        // 抢到槽位后才构造，失败时 item 不会被移走
+        new (cell->storage) T(std::forward<U>(item));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 取出的元素以右值交给 sink，不要求 T 可默认构造
+    template <typename Sink>
+    bool tryPop(Sink &&sink) {
+        Cell *cell;
+        size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (dif == 0) {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false;  // 空
+            } else {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T *value = std::launder(reinterpret_cast<T *>(cell->storage));
+        sink(std::move(*value));
+        value->~T();
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename U>
+    bool tryPushNotify(U &&item) {
+        if (!tryPush(std::forward<U>(item))) {
+            return false;
+        }
+        _consumers.WakeOne();
+        return true;
+    }
+
+    template <typename Sink>
+    bool tryPopNotify(Sink &&sink) {
+        if (!tryPop(std::forward<Sink>(sink))) {
+            return false;
+        }
+        _producers.WakeOne();
+        return true;
+    }
+
+    // 关闭后 Pop 仍要先取完剩余元素，所以只有 op 失败时才看关闭标志（见 Parker::Park）
+    bool closed() const { return _isClose.load(std::memory_order_relaxed); }
+
+    template <typename U>
+    bool waitPush(U &&item, Deadline deadline) {
+        const bool ok = _producers.Park(
+            deadline,
+            [&] {
+                return tryPush(std::forward<U>(item));
+            },
+            [this] {
+                return closed();
+            });
+        if (ok) {
+            _consumers.WakeOne();
+        }
+        return ok;
+    }
+
+    bool waitPop(T &item, Deadline deadline) {
+        const bool ok = _consumers.Park(
+            deadline,
+            [&] {
+                return tryPop([&item](T &&value) {
+                    item = std::move(value);
+                });
+            },
+            [this] {
+                return closed();
+            });
+        if (ok) {
+            _producers.WakeOne();
+        }
+        return ok;
+    }
+
+    const size_t _mask;
+    std::unique_ptr<Cell[]> _cells;
+    alignas(kCacheLineSize) std::atomic<size_t> _enqueuePos{0};
+    alignas(kCacheLineSize) std::atomic<size_t> _dequeuePos{0};
+    alignas(kCacheLineSize) std::atomic<bool> _isClose{false};
+    Parker _producers;
+    Parker _consumers;
+};
+
+}  // namespace bre
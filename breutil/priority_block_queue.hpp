@@ -0,0 +1,470 @@
+#pragma once
+
+/** priority_block_queue.hpp
+ * 带优先级的有界阻塞队列，接口与 BlockQueue 保持一致（TryPush/TryPop、带超时的阻塞 Push/Pop、Close）。
+ * - PriorityBlockQueue<T, Compare>：二叉堆，任意优先级；同优先级按入队顺序出队。
+ * - LeveledBlockQueue<T, Levels>：固定 Levels 个优先级，每级一个环形数组、各自限容，
+ *   出队时用位图找到最高的非空级别，Push/Pop 都是 O(1)；积压的低优先级数据不会挡住高优先级的入队。
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ring_buffer.hpp"
+#include "spin_wait.hpp"
+
+namespace bre {
+
+/**
+ * @brief 堆实现的优先级阻塞队列
+ * @tparam Compare 与 std::priority_queue 相同：Compare(a, b) 为真表示 a 的优先级低于 b，默认大的先出队
+ */
+template <class T, class Compare = std::less<T>>
+class PriorityBlockQueue {
+public:
+    explicit PriorityBlockQueue(size_t MaxCapacity = 1024, const Compare &compare = Compare())
+        : _capacity(MaxCapacity), _heapCompare{compare} {
+        _heap.reserve(MaxCapacity);
+    }
+
+    ~PriorityBlockQueue() { Close(); }
+
+    // 禁止拷贝
+    PriorityBlockQueue(const PriorityBlockQueue &) = delete;
+    PriorityBlockQueue &operator=(const PriorityBlockQueue &) = delete;
+
+    void Close() {
+        {
+            std::lock_guard<std::mutex> locker(_mtx);
+            _isClose = true;
+        }
+        _condProducer.notify_all();
+        _condConsumer.notify_all();
+    }
+
+    bool IsClosed() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _isClose;
+    }
+
+    size_t Size() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _heap.size();
+    }
+
+    bool Empty() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _heap.empty();
+    }
+
+    bool Full() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _heap.size() >= _capacity;
+    }
+
+    size_t Capacity() const { return _capacity; }
+
+    // 获取优先级最高的元素，不取出
+    T Top() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        if (_heap.empty()) {
+            throw std::runtime_error("Queue is empty");
+        }
+        return _heap.front().value;
+    }
+
+    // 非阻塞 Push，如果队列满或已关闭则返回 false
+    bool TryPush(const T &item) { return tryPush(item); }
+
+    bool TryPush(T &&item) { return tryPush(std::move(item)); }
+
+    void Push(const T &item) {
+        if (!push(item, std::nullopt)) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    void Push(T &&item) {
+        if (!push(std::move(item), std::nullopt)) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    // 支持超时的 Push
+    template <typename Rep, typename Period>
+    bool Push(const T &item, const std::chrono::duration<Rep, Period> &timeout) {
+        return push(item, DeadlineAfter(timeout));
+    }
+
+    template <typename Rep, typename Period>
+    bool Push(T &&item, const std::chrono::duration<Rep, Period> &timeout) {
+        return push(std::move(item), DeadlineAfter(timeout));
+    }
+
+    // 非阻塞
+    std::optional<T> TryPop() {
+        std::optional<T> item;
+        std::lock_guard<std::mutex> locker(_mtx);
+        if (!_heap.empty()) {
+            popLocked(item);
+        }
+        return item;
+    }
+
+    // 取出优先级最高的元素，队列关闭且为空时返回 false
+    bool Pop(T &item) {
+        std::optional<T> value;
+        if (!pop(value, std::nullopt)) {
+            return false;
+        }
+        item = std::move(*value);
+        return true;
+    }
+
+    bool Pop(T &item, int timeout_ms) {
+        std::optional<T> value;
+        if (!pop(value, DeadlineAfter(std::chrono::milliseconds(timeout_ms)))) {
+            return false;
+        }
+        item = std::move(*value);
+        return true;
+    }
+
+private:
+    using Deadline = std::optional<std::chrono::steady_clock::time_point>;
+
+    // 序号用于同优先级之间的先后：先入队的序号小，优先出队
+    struct Entry {
+        T value;
+        uint64_t seq;
+    };
+
+    struct HeapCompare {
+        Compare compare;
+
+        bool operator()(const Entry &a, const Entry &b) const {
+            if (compare(a.value, b.value)) {
+                return true;
+            }
+            if (compare(b.value, a.value)) {
+                return false;
+            }
+            return a.seq > b.seq;
+        }
+    };
+
+    // deadline 为 nullopt 表示一直等待
+    template <typename Pred>
+    bool waitUntil(std::condition_variable &cond, size_t &waiters, std::unique_lock<std::mutex> &locker,
+                   Deadline deadline, Pred pred) {
+        if (pred()) {
+            return true;
+        }
+        ++waiters;
+        bool ok = true;
+        if (deadline) {
+            ok = cond.wait_until(locker, *deadline, pred);
+        } else {
+            cond.wait(locker, pred);
+        }
+        --waiters;
+        return ok;
+    }
+
+    // 非阻塞路径只加锁检查，不登记等待者，也不碰条件变量
+    template <typename U>
+    bool tryPush(U &&item) {
+        std::lock_guard<std::mutex> locker(_mtx);
+        if (_isClose || _heap.size() >= _capacity) {
+            return false;
+        }
+        pushLocked(std::forward<U>(item));
+        return true;
+    }
+
+    template <typename U>
+    bool push(U &&item, Deadline deadline) {
+        std::unique_lock<std::mutex> locker(_mtx);
+        if (!waitUntil(_condProducer, _waitingProducers, locker, deadline, [this] {
+                return _isClose || _heap.size() < _capacity;
+            }) ||
+            _isClose) {
+            return false;
+        }
+        pushLocked(std::forward<U>(item));
+        return true;
+    }
+
+    bool pop(std::optional<T> &item, Deadline deadline) {
+        std::unique_lock<std::mutex> locker(_mtx);
+        if (!waitUntil(_condConsumer, _waitingConsumers, locker, deadline, [this] {
+                return _isClose || !_heap.empty();
+            }) ||
+            _heap.empty()) {
+            return false;
+        }
+        popLocked(item);
+        return true;
+    }
+
+    template <typename U>
+    void pushLocked(U &&item) {
+        _heap.push_back(Entry{std::forward<U>(item), _nextSeq++});
+        std::push_heap(_heap.begin(), _heap.end(), _heapCompare);
+        if (_waitingConsumers > 0) {
+            _condConsumer.notify_one();
+        }
+    }
+
+    void popLocked(std::optional<T> &item) {
+        std::pop_heap(_heap.begin(), _heap.end(), _heapCompare);
+        item.emplace(std::move(_heap.back().value));
+        _heap.pop_back();
+        if (_waitingProducers > 0) {
+            _condProducer.notify_one();
+        }
+    }
+
+    const size_t _capacity;
+    HeapCompare _heapCompare;
+    bool _isClose = false;
+    std::vector<Entry> _heap;
+    uint64_t _nextSeq = 0;
+    mutable std::mutex _mtx;
+    std::condition_variable _condConsumer;
+    std::condition_variable _condProducer;
+    size_t _waitingConsumers = 0;
+    size_t _waitingProducers = 0;
+};
+
+
+/**
+ * @brief 固定级数的优先级阻塞队列，级别 0 优先级最高
+ * 每级容量独立：低优先级积压满时，高优先级仍可入队
+ */
+template <class T, size_t Levels>
+class LeveledBlockQueue {
+    static_assert(Levels >= 1 && Levels <= 64, "Levels must be in [1, 64]");
+
+public:
+    explicit LeveledBlockQueue(size_t capacityPerLevel = 1024) : _capacityPerLevel(capacityPerLevel) {
+        for (auto &ring : _rings) {
+            ring.Reallocate(capacityPerLevel);
+        }
+    }
+
+    ~LeveledBlockQueue() { Close(); }
+
+    // 禁止拷贝
+    LeveledBlockQueue(const LeveledBlockQueue &) = delete;
+    LeveledBlockQueue &operator=(const LeveledBlockQueue &) = delete;
+
+    void Close() {
+        {
+            std::lock_guard<std::mutex> locker(_mtx);
+            _isClose = true;
+        }
+        for (auto &cond : _condProducer) {
+            cond.notify_all();
+        }
+        _condConsumer.notify_all();
+    }
+
+    bool IsClosed() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _isClose;
+    }
+
+    size_t Size() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _size;
+    }
+
+    // 指定级别的元素个数
+    size_t Size(size_t level) const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _rings[level].Size();
+    }
+
+    bool Empty() const {
+        std::lock_guard<std::mutex> locker(_mtx);
+        return _size == 0;
+    }
+
+    size_t CapacityPerLevel() const { return _capacityPerLevel; }
+
+    static constexpr size_t LevelCount() { return Levels; }
+
+    // 非阻塞 Push，该级别满或已关闭则返回 false；level 越界时抛出 std::out_of_range
+    bool TryPush(const T &item, size_t level) { return tryPush(item, level); }
+
+    bool TryPush(T &&item, size_t level) { return tryPush(std::move(item), level); }
+
+    void Push(const T &item, size_t level) {
+        if (!push(item, level, std::nullopt)) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    void Push(T &&item, size_t level) {
+        if (!push(std::move(item), level, std::nullopt)) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    // 支持超时的 Push
+    template <typename Rep, typename Period>
+    bool Push(const T &item, size_t level, const std::chrono::duration<Rep, Period> &timeout) {
+        return push(item, level, DeadlineAfter(timeout));
+    }
+
+    template <typename Rep, typename Period>
+    bool Push(T &&item, size_t level, const std::chrono::duration<Rep, Period> &timeout) {
+        return push(std::move(item), level, DeadlineAfter(timeout));
+    }
+
+    // 非阻塞，取出最高优先级级别的队首
+    std::optional<T> TryPop() {
+        std::optional<T> item;
+        std::lock_guard<std::mutex> locker(_mtx);
+        if (_nonEmpty != 0) {
+            popLocked(item, nullptr);
+        }
+        return item;
+    }
+
+    // 取出最高优先级级别的队首，队列关闭且为空时返回 false；level 非空时输出所在级别
+    bool Pop(T &item, size_t *level = nullptr) {
+        std::optional<T> value;
+        if (!pop(value, level, std::nullopt)) {
+            return false;
+        }
+        item = std::move(*value);
+        return true;
+    }
+
+    bool Pop(T &item, int timeout_ms, size_t *level = nullptr) {
+        std::optional<T> value;
+        if (!pop(value, level, DeadlineAfter(std::chrono::milliseconds(timeout_ms)))) {
+            return false;
+        }
+        item = std::move(*value);
+        return true;
+    }
+
+private:
+    using Deadline = std::optional<std::chrono::steady_clock::time_point>;
+
+    template <typename Pred>
+    bool waitUntil(std::condition_variable &cond, size_t &waiters, std::unique_lock<std::mutex> &locker,
+                   Deadline deadline, Pred pred) {
+        if (pred()) {
+            return true;
+        }
+        ++waiters;
+        bool ok = true;
+        if (deadline) {
+            ok = cond.wait_until(locker, *deadline, pred);
+        } else {
+            cond.wait(locker, pred);
+        }
+        --waiters;
+        return ok;
+    }
+
+    static void checkLevel(size_t level) {
+        if (level >= Levels) {
+            throw std::out_of_range("Priority level out of range");
+        }
+    }
+
+    // 非阻塞路径只加锁检查，不登记等待者，也不碰条件变量
+    template <typename U>
+    bool tryPush(U &&item, size_t level) {
+        checkLevel(level);
+        std::lock_guard<std::mutex> locker(_mtx);
+        if (_isClose || _rings[level].Size() >= _capacityPerLevel) {
+            return false;
+        }
+        pushLocked(std::forward<U>(item), level);
+        return true;
+    }
+
+    template <typename U>
+    bool push(U &&item, size_t level, Deadline deadline) {
+        checkLevel(level);
+        RingBuffer<T> &ring = _rings[level];
+        std::unique_lock<std::mutex> locker(_mtx);
+        if (!waitUntil(_condProducer[level], _waitingProducers[level], locker, deadline, [this, &ring] {
+                return _isClose || ring.Size() < _capacityPerLevel;
+            }) ||
+            _isClose) {
+            return false;
+        }
+        pushLocked(std::forward<U>(item), level);
+        return true;
+    }
+
+    bool pop(std::optional<T> &item, size_t *level, Deadline deadline) {
+        std::unique_lock<std::mutex> locker(_mtx);
+        if (!waitUntil(_condConsumer, _waitingConsumers, locker, deadline, [this] {
+                return _isClose || _nonEmpty != 0;
+            }) ||
+            _nonEmpty == 0) {
+            return false;
+        }
+        popLocked(item, level);
+        return true;
+    }
+
+    template <typename U>
+    void pushLocked(U &&item, size_t level) {
+        _rings[level].PushBack(std::forward<U>(item));
+        _nonEmpty |= uint64_t{1} << level;
+        ++_size;
+        if (_waitingConsumers > 0) {
+            _condConsumer.notify_one();
+        }
+    }
+
+    void popLocked(std::optional<T> &item, size_t *level) {
+        // 最低位的 1 即最高优先级的非空级别
+        const size_t top = static_cast<size_t>(std::countr_zero(_nonEmpty));
+        RingBuffer<T> &ring = _rings[top];
+        item.emplace(std::move(ring.Front()));
+        ring.PopFront();
+        if (ring.Empty()) {
+            _nonEmpty &= ~(uint64_t{1} << top);
+        }
+        --_size;
+        if (level != nullptr) {
+            *level = top;
+        }
+        if (_waitingProducers[top] > 0) {
+            _condProducer[top].notify_one();
+        }
+    }
+
+    const size_t _capacityPerLevel;
+    bool _isClose = false;
+    std::array<RingBuffer<T>, Levels> _rings;
+    uint64_t _nonEmpty = 0;  // 第 i 位表示级别 i 非空
+    size_t _size = 0;
+    mutable std::mutex _mtx;
+    std::condition_variable _condConsumer;
+    std::array<std::condition_variable, Levels> _condProducer;
+    size_t _waitingConsumers = 0;
+    std::array<size_t, Levels> _waitingProducers{};
+};
+
+}  // namespace bre
@@ -0,0 +1,206 @@
+#pragma once
+
+/** queue_metrics.hpp
+ * 阻塞队列的可选运行时统计。
+ * 编译时定义 BRE_QUEUE_METRICS=1（或打开 CMake 选项 BRE_QUEUE_METRICS）后，BlockQueue 会记录：
+ * 入队/出队计数、Push/Pop 挂起在条件变量上的时长、元素在队列中的停留时长、元素个数的高水位、
+ * TryPush 因队列满被拒绝的次数，并通过 GetMetrics() 导出快照。
+ * 未开启时记录器是空类型，埋点都是空的内联函数，不读时钟也不占存储。
+ * 该宏会改变 BlockQueue 的布局，同一程序内必须保持一致。
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ring_buffer.hpp"
+
+#ifndef BRE_QUEUE_METRICS
+#define BRE_QUEUE_METRICS 0
+#endif
+
+namespace bre {
+
+inline constexpr bool kQueueMetricsEnabled = BRE_QUEUE_METRICS != 0;
+
+/**
+ * @brief 按 2 的幂分桶的耗时直方图：第 i 个桶统计 [2^i, 2^(i+1)) 纳秒，0 计入第 0 个桶
+ * 不加锁，由持有队列锁的一方更新
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t kBuckets = 40;  // 约 18 分钟以上的耗时都计入最后一个桶
+
+    void Record(std::chrono::nanoseconds value) {
+        const uint64_t ns = value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0;
+        const size_t bucket = ns == 0 ? 0 : std::min<size_t>(std::bit_width(ns) - 1, kBuckets - 1);
+        ++_buckets[bucket];
+        ++_count;
+        _sum += ns;
+        _max = std::max(_max, ns);
+    }
+
+    uint64_t Count() const { return _count; }
+
+    uint64_t Bucket(size_t index) const { return _buckets[index]; }
+
+    std::chrono::nanoseconds Total() const { return std::chrono::nanoseconds(_sum); }
+
+    std::chrono::nanoseconds Max() const { return std::chrono::nanoseconds(_max); }
+
+    std::chrono::nanoseconds Mean() const { return std::chrono::nanoseconds(_count == 0 ? 0 : _sum / _count); }
+
+    /**
+     * @brief 近似分位数，返回该分位所在桶的上界（不超过最大值）
+     * @param p 取值 [0, 1]
+     */
+    std::chrono::nanoseconds Percentile(double p) const {
+        if (_count == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        const auto rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * _count)), 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += _buckets[i];
+            if (seen >= rank) {
+                const uint64_t upper = (uint64_t(2) << i) - 1;
+                return std::chrono::nanoseconds(std::min(upper, _max));
+            }
+        }
+        return std::chrono::nanoseconds(_max);
+    }
+
+private:
+    std::array<uint64_t, kBuckets> _buckets{};
+    uint64_t _count = 0;
+    uint64_t _sum = 0;
+    uint64_t _max = 0;
+};
+
+/**
+ * @brief 某一时刻的统计快照；速率由两次快照相减得到
+ */
+struct QueueMetricsSnapshot {
+    bool enabled = false;  // 编译时未开启统计时为 false，其余字段均为 0
+    std::chrono::steady_clock::time_point time;
+    uint64_t pushed = 0;
+    uint64_t popped = 0;
+    uint64_t tryPushRejected = 0;    // TryPush 因队列满返回 false 的次数
+    size_t highWaterMark = 0;        // 出现过的最大元素个数
+    LatencyHistogram pushBlocked;    // Push 挂起等待空位的时长（不含挂起前的自旋）
+    LatencyHistogram popBlocked;     // Pop/Peek 挂起等待元素的时长
+    LatencyHistogram residence;      // 元素从入队到出队的时长，Clear 掉的元素不计
+
+    // 自 earlier 以来每秒入队的元素个数
+    double PushRate(const QueueMetricsSnapshot &earlier) const { return rate(pushed, earlier.pushed, earlier); }
+
+    // 自 earlier 以来每秒出队的元素个数
+    double PopRate(const QueueMetricsSnapshot &earlier) const { return rate(popped, earlier.popped, earlier); }
+
+private:
+    double rate(uint64_t now, uint64_t before, const QueueMetricsSnapshot &earlier) const {
+        const std::chrono::duration<double> elapsed = time - earlier.time;
+        return elapsed.count() > 0 ? static_cast<double>(now - before) / elapsed.count() : 0.0;
+    }
+};
+
+/**
+ * @brief 开启统计时队列使用的记录器，所有方法都在队列锁内调用
+ * 每个元素的入队时刻按 FIFO 存在一个与队列同步进出的环形缓冲中，出队时得到停留时长
+ */
+class QueueMetrics {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 入队时刻的缓冲与队列存储同样大小，在构造和调整容量时分配，OnPush 不在队列锁内申请内存
+    void SetCapacity(size_t capacity) {
+        capacity = std::max(capacity, _enqueueTimes.Size());
+        if (capacity != _enqueueTimes.Capacity()) {
+            _enqueueTimes.Reallocate(capacity);
+        }
+    }
+
+    void OnPush(size_t size) {
+        ++_pushed;
+        _highWaterMark = std::max(_highWaterMark, size);
+        if (_enqueueTimes.Full()) {
+            // 容量与队列同步，正常走不到这里
+            _enqueueTimes.Reallocate(std::max<size_t>(_enqueueTimes.Capacity() * 2, 16));
+        }
+        _enqueueTimes.PushBack(Clock::now());
+    }
+
+    void OnPop() {
+        ++_popped;
+        if (!_enqueueTimes.Empty()) {
+            _residence.Record(Clock::now() - _enqueueTimes.Front());
+            _enqueueTimes.PopFront();
+        }
+    }
+
+    // 一次出队 count 个元素（如 DrainAll），只读一次时钟
+    void OnPopBatch(size_t count) {
+        _popped += count;
+        const auto now = Clock::now();
+        for (; count > 0 && !_enqueueTimes.Empty(); --count) {
+            _residence.Record(now - _enqueueTimes.Front());
+            _enqueueTimes.PopFront();
+        }
+    }
+
+    void OnClear() { _enqueueTimes.Clear(); }
+
+    void OnTryPushRejected() { ++_tryPushRejected; }
+
+    void RecordPushBlocked(std::chrono::nanoseconds waited) { _pushBlocked.Record(waited); }
+
+    void RecordPopBlocked(std::chrono::nanoseconds waited) { _popBlocked.Record(waited); }
+
+    QueueMetricsSnapshot Snapshot() const {
+        QueueMetricsSnapshot snapshot;
+        snapshot.enabled = true;
+        snapshot.time = Clock::now();
+        snapshot.pushed = _pushed;
+        snapshot.popped = _popped;
+        snapshot.tryPushRejected = _tryPushRejected;
+        snapshot.highWaterMark = _highWaterMark;
+        snapshot.pushBlocked = _pushBlocked;
+        snapshot.popBlocked = _popBlocked;
+        snapshot.residence = _residence;
+        return snapshot;
+    }
+
+private:
+    uint64_t _pushed = 0;
+    uint64_t _popped = 0;
+    uint64_t _tryPushRejected = 0;
+    size_t _highWaterMark = 0;
+    LatencyHistogram _pushBlocked;
+    LatencyHistogram _popBlocked;
+    LatencyHistogram _residence;
+    RingBuffer<Clock::time_point> _enqueueTimes;
+};
+
+// 未开启统计时的空记录器
+class NullQueueMetrics {
+public:
+    void SetCapacity(size_t) {}
+    void OnPush(size_t) {}
+    void OnPop() {}
+    void OnPopBatch(size_t) {}
+    void OnClear() {}
+    void OnTryPushRejected() {}
+    void RecordPushBlocked(std::chrono::nanoseconds) {}
+    void RecordPopBlocked(std::chrono::nanoseconds) {}
+
+    QueueMetricsSnapshot Snapshot() const { return {}; }
+};
+
+using QueueMetricsRecorder = std::conditional_t<kQueueMetricsEnabled, QueueMetrics, NullQueueMetrics>;
+
+}  // namespace bre
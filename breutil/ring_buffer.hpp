@@ -0,0 +1,151 @@
+#pragma once
+
+/** ring_buffer.hpp
+ * 定长环形数组：一次性分配连续存储，元素用 placement new 就地构造。
+ * 压入/弹出只移动下标，不会触碰分配器；只有 Reallocate 才重新分配并搬移元素。
+ * 非线程安全，供 BlockQueue 等容器在锁内使用。
+ */
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace bre {
+
+template <class T>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity = 0) : _data(allocate(capacity)), _capacity(capacity) {}
+
+    ~RingBuffer() {
+        Clear();
+        deallocate(_data, _capacity);
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    RingBuffer(RingBuffer &&other) noexcept
+        : _data(other._data), _capacity(other._capacity), _head(other._head), _size(other._size) {
+        other._data = nullptr;
+        other._capacity = 0;
+        other._head = 0;
+        other._size = 0;
+    }
+
+    RingBuffer &operator=(RingBuffer &&other) noexcept {
+        if (this != &other) {
+            RingBuffer(std::move(other)).Swap(*this);
+        }
+        return *this;
+    }
+
+    size_t Size() const { return _size; }
+
+    size_t Capacity() const { return _capacity; }
+
+    bool Empty() const { return _size == 0; }
+
+    bool Full() const { return _size == _capacity; }
+
+    // 以下访问接口要求非空
+    T &Front() { return _data[_head]; }
+    const T &Front() const { return _data[_head]; }
+
+    T &Back() { return _data[index(_size - 1)]; }
+    const T &Back() const { return _data[index(_size - 1)]; }
+
+    // 从队首开始的第 i 个元素
+    T &operator[](size_t i) { return _data[index(i)]; }
+    const T &operator[](size_t i) const { return _data[index(i)]; }
+
+    /**
+     * @brief 在队尾就地构造，要求未满
+     */
+    template <typename... Args>
+    T &EmplaceBack(Args &&...args) {
+        T *slot = ::new (static_cast<void *>(_data + index(_size))) T(std::forward<Args>(args)...);
+        ++_size;
+        return *slot;
+    }
+
+    void PushBack(const T &item) { EmplaceBack(item); }
+
+    void PushBack(T &&item) { EmplaceBack(std::move(item)); }
+
+    /**
+     * @brief 析构队首元素，要求非空
+     */
+    void PopFront() {
+        _data[_head].~T();
+        _head = _head + 1 == _capacity ? 0 : _head + 1;
+        --_size;
+    }
+
+    /**
+     * @brief 析构所有元素，保留存储
+     */
+    void Clear() {
+        while (_size > 0) {
+            PopFront();
+        }
+        _head = 0;
+    }
+
+    /**
+     * @brief 重新分配存储并把元素按顺序搬到开头
+     * @param capacity 新容量，不能小于当前元素个数
+     */
+    void Reallocate(size_t capacity) {
+        T *data = allocate(capacity);
+        size_t moved = 0;
+        try {
+            for (; moved < _size; ++moved) {
+                ::new (static_cast<void *>(data + moved)) T(std::move_if_noexcept((*this)[moved]));
+            }
+        } catch (...) {
+            // 移动构造可能抛异常时退化为拷贝，失败则保持原样
+            while (moved > 0) {
+                data[--moved].~T();
+            }
+            deallocate(data, capacity);
+            throw;
+        }
+        const size_t size = _size;
+        Clear();
+        _size = size;
+        deallocate(_data, _capacity);
+        _data = data;
+        _capacity = capacity;
+        _head = 0;
+    }
+
+    void Swap(RingBuffer &other) noexcept {
+        std::swap(_data, other._data);
+        std::swap(_capacity, other._capacity);
+        std::swap(_head, other._head);
+        std::swap(_size, other._size);
+    }
+
+private:
+    static T *allocate(size_t capacity) { return capacity == 0 ? nullptr : std::allocator<T>().allocate(capacity); }
+
+    static void deallocate(T *data, size_t capacity) {
+        if (data != nullptr) {
+            std::allocator<T>().deallocate(data, capacity);
+        }
+    }
+
+    size_t index(size_t i) const {
+        const size_t pos = _head + i;
+        return pos >= _capacity ? pos - _capacity : pos;
+    }
+
+    T *_data;
+    size_t _capacity;
+    size_t _head = 0;  // 队首下标
+    size_t _size = 0;
+};
+
+}  // namespace bre
@@ -0,0 +1,299 @@
+#pragma once
+
+/** sharded_queue.hpp
+ * 多通道（分片）有界队列，用于大量生产者汇入少量消费者的场景。
+ * 每个生产者线程固定映射到一个通道，各通道有独立的锁与环形存储，生产者之间只在总容量计数上竞争；
+ * 消费者从轮转的起点依次扫描各通道取元素。同一生产者的元素在其通道内保持 FIFO，
+ * 不同生产者之间不保证全局顺序。
+ * 接口与 BlockQueue 保持一致：TryPush/TryPop、带超时的阻塞 Push/Pop、Close。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "ring_buffer.hpp"
+#include "spin_wait.hpp"
+
+namespace bre {
+
+template <class T>
+class ShardedQueue {
+public:
+    /**
+     * @param MaxCapacity 所有通道合计的容量
+     * @param laneCount 通道数，0 表示取 CPU 核数
+     */
+    explicit ShardedQueue(size_t MaxCapacity = 1024, size_t laneCount = 0)
+        : _capacity(MaxCapacity), _laneCount(resolveLaneCount(laneCount)), _lanes(new Lane[_laneCount]) {
+        // 各通道先按平均份额分配，某个通道积压时再成倍扩容，上限为总容量
+        const size_t share = (MaxCapacity + _laneCount - 1) / _laneCount;
+        for (size_t i = 0; i < _laneCount; ++i) {
+            _lanes[i].ring.Reallocate(share);
+        }
+    }
+
+    ~ShardedQueue() { Close(); }
+
+    // 禁止拷贝和移动
+    ShardedQueue(const ShardedQueue &) = delete;
+    ShardedQueue &operator=(const ShardedQueue &) = delete;
+
+    /**
+     * 关闭队列：之后的 Push 失败，Pop 取完剩余元素后返回 false。
+     * 与 Close 并发进行的 Push 仍可能成功入队
+     */
+    void Close() {
+        _isClose.store(true, std::memory_order_seq_cst);
+        _producers.WakeAll();
+        _consumers.WakeAll();
+    }
+
+    bool IsClosed() const { return _isClose.load(std::memory_order_acquire); }
+
+    // 近似快照，包含已占用容量但尚未写入通道的元素
+    size_t Size() const { return _size.load(std::memory_order_relaxed); }
+
+    bool Empty() const { return Size() == 0; }
+
+    bool Full() const { return Size() >= _capacity; }
+
+    size_t Capacity() const { return _capacity; }
+
+    size_t LaneCount() const { return _laneCount; }
+
+    // 非阻塞 Push，如果队列满或已关闭则返回 false
+    bool TryPush(const T &item) { return tryPushNotify(item); }
+
+    bool TryPush(T &&item) { return tryPushNotify(std::move(item)); }
+
+    void Push(const T &item) {
+        if (!waitPush(item, std::nullopt)) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    void Push(T &&item) {
+        if (!waitPush(std::move(item), std::nullopt)) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    // 支持超时的 Push
+    template <typename Rep, typename Period>
+    bool Push(const T &item, const std::chrono::duration<Rep, Period> &timeout) {
+        return waitPush(item, DeadlineAfter(timeout));
+    }
+
+    template <typename Rep, typename Period>
+    bool Push(T &&item, const std::chrono::duration<Rep, Period> &timeout) {
+        return waitPush(std::move(item), DeadlineAfter(timeout));
+    }
+
+    // 非阻塞
+    std::optional<T> TryPop() {
+        std::optional<T> item;
+        if (tryPop([&item](T &&value) {
+                item.emplace(std::move(value));
+            })) {
+            _producers.WakeOne();
+        }
+        return item;
+    }
+
+    // 从队列拿走一个元素，队列关闭且为空时返回 false
+    bool Pop(T &item) { return waitPop(item, std::nullopt); }
+
+    bool Pop(T &item, int timeout_ms) {
+        return waitPop(item, DeadlineAfter(std::chrono::milliseconds(timeout_ms)));
+    }
+
+    /**
+     * 批量操作：阻塞直到至少有一个元素，再按轮转顺序从各通道取出至多 maxCount 个
+     * 队列关闭且为空时返回 0
+     */
+    template <typename OutputIt>
+    size_t Pop(OutputIt dest, size_t maxCount) {
+        size_t count = 0;
+        _consumers.Park(
+            std::nullopt,
+            [&] {
+                count = drain(dest, maxCount);
+                return count > 0 || maxCount == 0;
+            },
+            [this] {
+                return drained();
+            });
+        for (size_t i = 0; i < count; ++i) {
+            _producers.WakeOne();
+        }
+        return count;
+    }
+
+private:
+    using Deadline = Parker::Deadline;
+
+    struct alignas(kCacheLineSize) Lane {
+        std::mutex mtx;
+        RingBuffer<T> ring;
+        std::atomic<size_t> size{0};  // ring.Size() 的镜像，消费者扫描时不加锁地跳过空通道
+    };
+
+    static size_t resolveLaneCount(size_t laneCount) {
+        if (laneCount == 0) {
+            laneCount = std::thread::hardware_concurrency();
+        }
+        return laneCount == 0 ? 1 : laneCount;
+    }
+
+    // 线程首次使用时分配一个全局编号，同一线程总是落在同一通道，保证其元素的 FIFO
+    static size_t producerId() {
+        static std::atomic<size_t> nextId{0};
+        thread_local const size_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    bool closed() const { return _isClose.load(std::memory_order_relaxed); }
+
+    // 已关闭且所有已占用的容量都被取走
+    bool drained() const { return closed() && _size.load(std::memory_order_acquire) == 0; }
+
+    /**
+     * 先占用总容量中的一个位置，再写入本线程的通道。
+     * 通道按平均份额预分配，只有生产者分布不均、某个通道积压超过份额时才在通道锁内成倍扩容，
+     * 之后保持扩容后的大小，稳态下不再分配。
+     * 扩容或构造元素抛出异常时归还占用的位置，否则容量永久减少，关闭后 Pop 也永远等不到 drained
+     */
+    template <typename U>
+    bool tryPush(U &&item) {
+        if (closed()) {
+            return false;
+        }
+        size_t size = _size.load(std::memory_order_relaxed);
+        do {
+            if (size >= _capacity) {
+                return false;
+            }
+        } while (!_size.compare_exchange_weak(size, size + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        Lane &lane = _lanes[producerId() % _laneCount];
+        std::lock_guard<std::mutex> locker(lane.mtx);
+        try {
+            if (lane.ring.Full()) {
+                lane.ring.Reallocate(std::min(std::max<size_t>(lane.ring.Capacity() * 2, 1), _capacity));
+            }
+            lane.ring.PushBack(std::forward<U>(item));
+        } catch (...) {
+            _size.fetch_sub(1, std::memory_order_release);
+            throw;
+        }
+        lane.size.store(lane.ring.Size(), std::memory_order_release);
+        return true;
+    }
+
+    template <typename U>
+    bool tryPushNotify(U &&item) {
+        if (!tryPush(std::forward<U>(item))) {
+            return false;
+        }
+        _consumers.WakeOne();
+        return true;
+    }
+
+    // 从轮转起点开始找第一个非空通道
+    template <typename Sink>
+    bool tryPop(Sink &&sink) {
+        const size_t start = _cursor.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < _laneCount; ++i) {
+            Lane &lane = _lanes[(start + i) % _laneCount];
+            if (lane.size.load(std::memory_order_acquire) == 0) {
+                continue;
+            }
+            std::lock_guard<std::mutex> locker(lane.mtx);
+            if (lane.ring.Empty()) {
+                continue;
+            }
+            sink(std::move(lane.ring.Front()));
+            lane.ring.PopFront();
+            lane.size.store(lane.ring.Size(), std::memory_order_relaxed);
+            _size.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+        return false;
+    }
+
+    // 一次加锁取走一个通道中的多个元素
+    template <typename OutputIt>
+    size_t drain(OutputIt &dest, size_t maxCount) {
+        const size_t start = _cursor.fetch_add(1, std::memory_order_relaxed);
+        size_t count = 0;
+        for (size_t i = 0; i < _laneCount && count < maxCount; ++i) {
+            Lane &lane = _lanes[(start + i) % _laneCount];
+            if (lane.size.load(std::memory_order_acquire) == 0) {
+                continue;
+            }
+            std::lock_guard<std::mutex> locker(lane.mtx);
+            size_t taken = 0;
+            while (!lane.ring.Empty() && count < maxCount) {
+                *dest++ = std::move(lane.ring.Front());
+                lane.ring.PopFront();
+                ++taken;
+                ++count;
+            }
+            lane.size.store(lane.ring.Size(), std::memory_order_relaxed);
+            _size.fetch_sub(taken, std::memory_order_release);
+        }
+        return count;
+    }
+
+    template <typename U>
+    bool waitPush(U &&item, Deadline deadline) {
+        const bool ok = _producers.Park(
+            deadline,
+            [&] {
+                return tryPush(std::forward<U>(item));
+            },
+            [this] {
+                return closed();
+            });
+        if (ok) {
+            _consumers.WakeOne();
+        }
+        return ok;
+    }
+
+    bool waitPop(T &item, Deadline deadline) {
+        const bool ok = _consumers.Park(
+            deadline,
+            [&] {
+                return tryPop([&item](T &&value) {
+                    item = std::move(value);
+                });
+            },
+            [this] {
+                return drained();
+            });
+        if (ok) {
+            _producers.WakeOne();
+        }
+        return ok;
+    }
+
+    const size_t _capacity;
+    const size_t _laneCount;
+    std::unique_ptr<Lane[]> _lanes;
+    alignas(kCacheLineSize) std::atomic<size_t> _size{0};
+    alignas(kCacheLineSize) std::atomic<size_t> _cursor{0};
+    alignas(kCacheLineSize) std::atomic<bool> _isClose{false};
+    Parker _producers;
+    Parker _consumers;
+};
+
+}  // namespace bre
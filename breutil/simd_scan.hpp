@@ -0,0 +1,148 @@
+#pragma once
+
+/** simd_scan.hpp
+ * 字节扫描内核：在 [begin, end) 中查找单字节或双字节分隔符（如 '\n'、"\r\n"）。
+ * 双字节查找在 x86 平台提供 SSE2 / AVX2 实现，首次调用时按 CPU 能力选择；其他平台回退到标量实现。
+ * 单字节查找直接使用 memchr：主流 libc 的 memchr 已经向量化，实测快于手写的 SSE2/AVX2 循环。
+ * SSE2 依赖 cmake/compiler.cmake 中 ARCH_SIMD_FLAGS 打开的 -msse2，
+ * AVX2 通过函数级 target 属性编译，不需要全局 -mavx2。
+ */
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BRE_SIMD_X86 1
+#endif
+#endif
+
+#ifdef BRE_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(BRE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BRE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define BRE_TARGET_AVX2
+#endif
+
+namespace bre::simd {
+
+using FindPairFn = const char* (*)(const char*, const char*, char, char);
+
+// ==================== 标量实现 ====================
+
+inline const char* FindPairScalar(const char* begin, const char* end, char first, char second) {
+    for (const char* p = begin; p + 1 < end; ++p) {
+        if (p[0] == first && p[1] == second) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+#ifdef BRE_SIMD_X86
+
+// ==================== SSE2 实现 ====================
+
+// 同时加载 p 与 p + 1 两个错位块，两次比较结果相与即为双字节匹配的起点
+inline const char* FindPairSse2(const char* begin, const char* end, char first, char second) {
+    if (begin >= end) {
+        return nullptr;
+    }
+    const __m128i n0 = _mm_set1_epi8(first);
+    const __m128i n1 = _mm_set1_epi8(second);
+    const char* p = begin;
+    for (; end - p >= 17; p += 16) {
+        const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+        const __m128i hit = _mm_and_si128(_mm_cmpeq_epi8(b0, n0), _mm_cmpeq_epi8(b1, n1));
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+        if (mask != 0) {
+            return p + std::countr_zero(mask);
+        }
+    }
+    return FindPairScalar(p, end, first, second);
+}
+
+// ==================== AVX2 实现 ====================
+
+BRE_TARGET_AVX2 inline const char* FindPairAvx2(const char* begin, const char* end, char first, char second) {
+    if (begin >= end) {
+        return nullptr;
+    }
+    const __m256i n0 = _mm256_set1_epi8(first);
+    const __m256i n1 = _mm256_set1_epi8(second);
+    const char* p = begin;
+    for (; end - p >= 33; p += 32) {
+        const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1));
+        const __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi8(b0, n0), _mm256_cmpeq_epi8(b1, n1));
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(hit));
+        if (mask != 0) {
+            return p + std::countr_zero(mask);
+        }
+    }
+    return FindPairSse2(p, end, first, second);
+}
+
+#endif  // BRE_SIMD_X86
+
+// ==================== 运行时分派 ====================
+
+/**
+ * @brief 当前 CPU 与操作系统是否支持 AVX2
+ */
+inline bool HasAvx2() {
+#if defined(BRE_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    static const bool kHasAvx2 = __builtin_cpu_supports("avx2");
+    return kHasAvx2;
+#elif defined(BRE_SIMD_X86) && defined(_MSC_VER)
+    static const bool kHasAvx2 = [] {
+        int info[4];
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        __cpuidex(info, 7, 0);
+        const bool avx2 = (info[1] & (1 << 5)) != 0;
+        return osxsave && avx2 && (_xgetbv(0) & 0x6) == 0x6;
+    }();
+    return kHasAvx2;
+#else
+    return false;
+#endif
+}
+
+inline FindPairFn ResolveFindPair() {
+#ifdef BRE_SIMD_X86
+    return HasAvx2() ? FindPairAvx2 : FindPairSse2;
+#else
+    return FindPairScalar;
+#endif
+}
+
+/**
+ * @brief 查找单字节
+ * @return 第一个等于 c 的位置，不存在返回 nullptr
+ */
+inline const char* FindChar(const char* begin, const char* end, char c) {
+    if (begin >= end) {
+        return nullptr;
+    }
+    return static_cast<const char*>(std::memchr(begin, c, static_cast<size_t>(end - begin)));
+}
+
+/**
+ * @brief 查找连续的两个字节 first second
+ * @return 匹配的起始位置（指向 first），不存在返回 nullptr
+ */
+inline const char* FindPair(const char* begin, const char* end, char first, char second) {
+    static const FindPairFn kFindPair = ResolveFindPair();
+    return kFindPair(begin, end, first, second);
+}
+
+}  // namespace bre::simd
@@ -0,0 +1,239 @@
+#pragma once
+
+/** spin_wait.hpp
+ * 无锁结构共用的小工具：缓存行大小、自旋等待时的 CPU 提示指令、阻塞队列的自旋等待策略，
+ * 相对超时到截止时间的换算，以及无锁队列在满/空时挂起线程用的 Parker。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#endif
+
+namespace bre {
+
+// 按 64 字节对齐可以避免相邻的原子变量落在同一缓存行造成伪共享
+inline constexpr size_t kCacheLineSize = 64;
+
+/**
+ * @brief 自旋循环中提示 CPU 当前处于忙等，降低功耗并让出超线程的执行资源
+ */
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * @brief 阻塞队列在条件不满足时的等待方式
+ */
+enum class WaitStrategy {
+    Block,           // 直接挂起在条件变量上
+    YieldThenBlock,  // 先 yield 若干次，仍不满足再挂起
+    SpinThenBlock,   // 先 CpuRelax 忙等（预算自适应），再 yield，最后挂起
+};
+
+/**
+ * @brief 自适应自旋预算
+ * 自旋内等到时，预算向实际所需次数的两倍靠拢；不得不挂起时按挂起时长估算：
+ * 能在最大预算内等到的就加大预算，等待更久的说明自旋是浪费，预算回落到最小值。
+ * 多个线程共享同一个实例，预算的读写是无锁的近似更新。
+ */
+class AdaptiveSpin {
+public:
+    static constexpr uint32_t kMinSpins = 16;
+    static constexpr uint32_t kMaxSpins = 8192;
+    static constexpr int kYieldCount = 4;
+
+    /**
+     * @brief 忙等 ready 成立
+     * @return true 表示在预算内等到；false 表示预算用完，调用方应挂起，并在之后调用 Parked
+     */
+    template <typename Ready>
+    bool Spin(Ready &&ready) {
+        return spin(ready, [] {
+            return false;
+        });
+    }
+
+    /**
+     * @brief 同 Spin，但不越过 deadline：每自旋 kDeadlineCheckInterval 次读一次时钟，
+     * 截止时间已到（包括调用时已过期）就按预算用完返回 false，预算不因此调整
+     */
+    template <typename Ready>
+    bool Spin(Ready &&ready, std::chrono::steady_clock::time_point deadline) {
+        return spin(ready, [deadline] {
+            return std::chrono::steady_clock::now() >= deadline;
+        });
+    }
+
+    /**
+     * @brief 报告自旋失败后挂起等待的时长
+     */
+    void Parked(std::chrono::nanoseconds waited) {
+        const uint64_t spins = static_cast<uint64_t>(waited.count()) / kNanosPerSpin;
+        update(spins < kMaxSpins ? static_cast<uint32_t>(2 * spins) : kMinSpins);
+    }
+
+    uint32_t Budget() const { return _budget.load(std::memory_order_relaxed); }
+
+private:
+    // 一次 CpuRelax 的大致耗时，用于把挂起时长折算成自旋次数
+    static constexpr uint64_t kNanosPerSpin = 20;
+    // 带截止时间自旋时读时钟的间隔，约 1us
+    static constexpr uint32_t kDeadlineCheckInterval = 64;
+
+    template <typename Ready, typename Expired>
+    bool spin(Ready &ready, Expired expired) {
+        const uint32_t budget = _budget.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < budget; ++i) {
+            if (ready()) {
+                update(2 * i);
+                return true;
+            }
+            if (i % kDeadlineCheckInterval == 0 && expired()) {
+                return false;
+            }
+            CpuRelax();
+        }
+        for (int i = 0; i < kYieldCount; ++i) {
+            if (ready()) {
+                update(2 * budget);
+                return true;
+            }
+            if (expired()) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    void update(uint32_t target) {
+        target = std::clamp(target, kMinSpins, kMaxSpins);
+        const uint32_t budget = _budget.load(std::memory_order_relaxed);
+        _budget.store((budget * 3 + target) / 4, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint32_t> _budget{256};
+};
+
+/**
+ * @brief 相对超时换算为 steady_clock 的截止时间
+ * 不受系统时间调整影响；向上取整到时钟精度（不会提前返回），非正数表示立即超时，
+ * 超出表示范围（如 duration::max() 表示一直等）时饱和为 time_point::max()
+ */
+template <typename Rep, typename Period>
+std::chrono::steady_clock::time_point DeadlineAfter(const std::chrono::duration<Rep, Period> &timeout) {
+    using Clock = std::chrono::steady_clock;
+    const auto now = Clock::now();
+    if (timeout <= timeout.zero()) {
+        return now;
+    }
+    // 用浮点比较，避免把很大的时长换算成纳秒时溢出
+    if (std::chrono::duration<double>(timeout) >= std::chrono::duration<double>(Clock::time_point::max() - now)) {
+        return Clock::time_point::max();
+    }
+    return now + std::chrono::ceil<Clock::duration>(timeout);
+}
+
+/**
+ * @brief 无锁结构的挂起与唤醒
+ * 操作本身不加锁；只有在确实有线程挂起时，唤醒方才加锁通知条件变量。
+ * 等待计数的登记与唤醒方各有一个 seq_cst fence，保证不会丢失唤醒
+ */
+class Parker {
+public:
+    using Deadline = std::optional<std::chrono::steady_clock::time_point>;
+
+    static constexpr int kSpinCount = 64;
+
+    // 唤醒一个挂起的线程，没有线程挂起时不加锁
+    void WakeOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> locker(_mtx);
+            _cond.notify_one();
+        }
+    }
+
+    // 唤醒所有挂起的线程，用于关闭等状态变化；stop 对应的标志需在调用前设置
+    void WakeAll() {
+        std::lock_guard<std::mutex> locker(_mtx);
+        _cond.notify_all();
+    }
+
+    /**
+     * @brief 反复尝试 op 直到成功、stop() 为真或超时；先短暂自旋，仍不成功再挂起
+     * stop() 为真后还会再尝试一次 op，保证关闭后仍能取完剩余元素
+     * 挂起期间持有内部锁，op 中不能调用同一个 Parker 的 WakeOne
+     * @return op 是否成功
+     */
+    template <typename Op, typename Stop>
+    bool Park(Deadline deadline, Op &&op, Stop &&stop) {
+        for (int i = 0; i < kSpinCount; ++i) {
+            if (op()) {
+                return true;
+            }
+            if (stop()) {
+                return op();
+            }
+            if (i < kSpinCount / 2) {
+                CpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        std::unique_lock<std::mutex> locker(_mtx);
+        _waiters.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool ok = false;
+        try {
+            for (;;) {
+                if (op()) {
+                    ok = true;
+                    break;
+                }
+                if (stop()) {
+                    ok = op();
+                    break;
+                }
+                if (!deadline) {
+                    _cond.wait(locker);
+                } else if (_cond.wait_until(locker, *deadline) == std::cv_status::timeout) {
+                    ok = op();
+                    break;
+                }
+            }
+        } catch (...) {
+            // op 抛出异常时也要注销，否则之后每次 WakeOne 都会白白加锁
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+private:
+    std::atomic<int> _waiters{0};
+    std::mutex _mtx;
+    std::condition_variable _cond;
+};
+
+}  // namespace bre
@@ -0,0 +1,341 @@
+#pragma once
+
+/** spsc_queue.hpp
+ * 单生产者单消费者有界无锁队列。
+ * 容量为编译期的 2 的幂，下标用掩码取模；生产者与消费者各自缓存对方的下标，
+ * 只有在看起来满/空时才去读对方的原子变量，稳态下两端几乎不产生缓存行争用。
+ * Blocking 为 true 时，阻塞的 Push/Pop 在短暂自旋后通过 std::atomic::wait（Linux 上即 futex）挂起；
+ * 为 false 时阻塞接口只自旋+yield，TryPush/TryPop 也省去通知对端所需的内存屏障。
+ * Close()/IsClosed() 的语义与 BlockQueue 一致。
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "spin_wait.hpp"
+
+namespace bre {
+
+template <class T, size_t N, bool Blocking = true>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : _slots(new Slot[N]) {}
+
+    ~SpscQueue() {
+        size_t head = _head.load(std::memory_order_relaxed);
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        for (; head != tail; ++head) {
+            at(head)->~T();
+        }
+    }
+
+    // 禁止拷贝和移动
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * 关闭队列：之后的 Push 失败，Pop 取完剩余元素后返回 false，并唤醒挂起的两端
+     */
+    void Close() {
+        _isClose.store(true, std::memory_order_seq_cst);
+        if constexpr (Blocking) {
+            signal(_consumerSignal);
+            signal(_producerSignal);
+        }
+    }
+
+    bool IsClosed() const { return _isClose.load(std::memory_order_acquire); }
+
+    // 近似快照，可在任意线程调用
+    size_t Size() const {
+        const size_t head = _head.load(std::memory_order_acquire);
+        const size_t tail = _tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool Empty() const { return Size() == 0; }
+
+    bool Full() const { return Size() >= N; }
+
+    static constexpr size_t Capacity() { return N; }
+
+    // ==================== 生产者接口 ====================
+
+    // 非阻塞 Push，如果队列满或已关闭则返回 false
+    bool TryPush(const T &item) { return emplace(item); }
+
+    bool TryPush(T &&item) { return emplace(std::move(item)); }
+
+    template <typename... Args>
+    bool TryEmplace(Args &&...args) {
+        return emplace(std::forward<Args>(args)...);
+    }
+
+    // 阻塞直到有空位，队列关闭时抛出异常
+    void Push(const T &item) { waitPush(item); }
+
+    void Push(T &&item) { waitPush(std::move(item)); }
+
+    /**
+     * 批量操作：放入尽可能多的元素，只发布一次写下标
+     * 构造某个元素抛出异常时，之前构造好的元素照常发布，异常继续向外传递
+     * @return 成功放入的元素个数，队列满或关闭时可能小于输入个数
+     */
+    template <typename InputIt>
+    size_t Push(InputIt first, InputIt last) {
+        if (_isClose.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        _headCache = _head.load(std::memory_order_acquire);
+        const size_t free = N - (tail - _headCache);
+        size_t count = 0;
+        try {
+            for (; first != last && count < free; ++first, ++count) {
+                new (at(tail + count)) T(*first);
+            }
+        } catch (...) {
+            publish(tail, count);
+            throw;
+        }
+        publish(tail, count);
+        return count;
+    }
+
+    // ==================== 消费者接口 ====================
+
+    // 非阻塞
+    std::optional<T> TryPop() {
+        std::optional<T> item;
+        if (tryPop([&item](T &&value) {
+                item.emplace(std::move(value));
+            })) {
+            wakeProducer();
+        }
+        return item;
+    }
+
+    // 阻塞直到取到元素，队列关闭且为空时返回 false
+    bool Pop(T &item) {
+        bool ok = false;
+        wait(_consumerSignal, _consumerWaiting, [&] {
+            ok = tryPop([&item](T &&value) {
+                item = std::move(value);
+            });
+            return ok;
+        });
+        if (ok) {
+            wakeProducer();
+        }
+        return ok;
+    }
+
+    /**
+     * 批量操作：非阻塞地取出至多 maxCount 个元素，只发布一次读下标
+     */
+    template <typename OutputIt>
+    size_t TryPop(OutputIt dest, size_t maxCount) {
+        const size_t count = popBatch(dest, maxCount);
+        if (count > 0) {
+            wakeProducer();
+        }
+        return count;
+    }
+
+    /**
+     * 批量操作：阻塞直到至少有一个元素，再取出至多 maxCount 个；队列关闭且为空时返回 0
+     */
+    template <typename OutputIt>
+    size_t Pop(OutputIt dest, size_t maxCount) {
+        size_t count = 0;
+        wait(_consumerSignal, _consumerWaiting, [&] {
+            count = popBatch(dest, maxCount);
+            return count > 0 || maxCount == 0;
+        });
+        if (count > 0) {
+            wakeProducer();
+        }
+        return count;
+    }
+
+private:
+    static constexpr size_t kMask = N - 1;
+    static constexpr int kSpinCount = 128;
+
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    void publish(size_t tail, size_t count) {
+        if (count > 0) {
+            _tail.store(tail + count, std::memory_order_release);
+            wakeConsumer();
+        }
+    }
+
+    T *at(size_t index) { return std::launder(reinterpret_cast<T *>(_slots[index & kMask].storage)); }
+
+    template <typename... Args>
+    bool emplace(Args &&...args) {
+        if (!tryEmplace(std::forward<Args>(args)...)) {
+            return false;
+        }
+        wakeConsumer();
+        return true;
+    }
+
+    template <typename... Args>
+    bool tryEmplace(Args &&...args) {
+        if (_isClose.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _headCache == N) {
+            _headCache = _head.load(std::memory_order_acquire);
+            if (tail - _headCache == N) {
+                return false;
+            }
+        }
+        new (_slots[tail & kMask].storage) T(std::forward<Args>(args)...);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 取出的元素以右值交给 sink，不要求 T 可默认构造
+    template <typename Sink>
+    bool tryPop(Sink &&sink) {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tailCache) {
+            _tailCache = _tail.load(std::memory_order_acquire);
+            if (head == _tailCache) {
+                return false;
+            }
+        }
+        T *value = at(head);
+        sink(std::move(*value));
+        value->~T();
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename OutputIt>
+    size_t popBatch(OutputIt &dest, size_t maxCount) {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        size_t available = _tailCache - head;
+        if (available < maxCount) {
+            _tailCache = _tail.load(std::memory_order_acquire);
+            available = _tailCache - head;
+        }
+        const size_t count = available < maxCount ? available : maxCount;
+        for (size_t i = 0; i < count; ++i) {
+            T *value = at(head + i);
+            *dest++ = std::move(*value);
+            value->~T();
+        }
+        if (count > 0) {
+            _head.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    template <typename U>
+    void waitPush(U &&item) {
+        bool ok = false;
+        wait(_producerSignal, _producerWaiting, [&] {
+            ok = tryEmplace(std::forward<U>(item));
+            return ok;
+        });
+        if (!ok) {
+            throw std::runtime_error("Queue is closed");
+        }
+        wakeConsumer();
+    }
+
+    /**
+     * 反复执行 op 直到成功或队列关闭。关闭后 Pop 仍要取完剩余元素，所以只有 op 失败时才看关闭标志。
+     * 挂起前先读信号值再登记等待标志，与 notify 一侧的 fence 配对，保证不会丢失唤醒
+     */
+    template <typename Op>
+    void wait(std::atomic<uint32_t> &sig, std::atomic<bool> &waiting, Op &&op) {
+        for (int i = 0;; ++i) {
+            if (op()) {
+                return;
+            }
+            if (_isClose.load(std::memory_order_acquire)) {
+                op();
+                return;
+            }
+            if (i < kSpinCount) {
+                CpuRelax();
+                continue;
+            }
+            if constexpr (!Blocking) {
+                std::this_thread::yield();
+            } else {
+                const uint32_t observed = sig.load(std::memory_order_acquire);
+                waiting.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (op()) {
+                    waiting.store(false, std::memory_order_relaxed);
+                    return;
+                }
+                if (!_isClose.load(std::memory_order_acquire)) {
+                    sig.wait(observed, std::memory_order_acquire);
+                }
+                waiting.store(false, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void wakeConsumer() {
+        if constexpr (Blocking) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // 清掉标志再唤醒，对端被调度前的后续操作不再重复进入内核
+            if (_consumerWaiting.load(std::memory_order_relaxed) && _consumerWaiting.exchange(false)) {
+                signal(_consumerSignal);
+            }
+        }
+    }
+
+    void wakeProducer() {
+        if constexpr (Blocking) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_producerWaiting.load(std::memory_order_relaxed) && _producerWaiting.exchange(false)) {
+                signal(_producerSignal);
+            }
+        }
+    }
+
+    static void signal(std::atomic<uint32_t> &sig) {
+        sig.fetch_add(1, std::memory_order_release);
+        sig.notify_all();
+    }
+
+    std::unique_ptr<Slot[]> _slots;
+
+    // 生产者写的缓存行。消费者的等待标志放在这里：生产者每次 Push 都要读它，
+    // 而消费者只在挂起前写一次
+    alignas(kCacheLineSize) std::atomic<size_t> _tail{0};
+    size_t _headCache = 0;
+    std::atomic<bool> _consumerWaiting{false};
+    std::atomic<uint32_t> _consumerSignal{0};
+
+    // 消费者写的缓存行，同理放生产者的等待标志
+    alignas(kCacheLineSize) std::atomic<size_t> _head{0};
+    size_t _tailCache = 0;
+    std::atomic<bool> _producerWaiting{false};
+    std::atomic<uint32_t> _producerSignal{0};
+
+    alignas(kCacheLineSize) std::atomic<bool> _isClose{false};
+};
+
+}  // namespace bre
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../async_queue.hpp"
+#include "../easy_test.hpp"
+#include "../thread_pool.hpp"
+
+using namespace bre;
+
+// 立即开始执行、结束时自行销毁的协程，测试中用来驱动 co_await
+struct AsyncQueueDetached {
+    struct promise_type {
+        AsyncQueueDetached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+static AsyncQueueDetached AsyncPopInto(AsyncQueue<int>& queue, std::optional<int>& out, bool& done) {
+    out = co_await queue.PopAsync();
+    done = true;
+}
+
+static AsyncQueueDetached AsyncPushFrom(AsyncQueue<int>& queue, int value, bool& ok, bool& done) {
+    ok = co_await queue.PushAsync(value);
+    done = true;
+}
+
+// ==================== 基础功能测试 ====================
+
+TEST_CASE(AsyncQueue_PopAsync_Ready) {
+    AsyncQueue<int> queue(4);
+    ASSERT_TRUE(queue.TryPush(7));
+
+    std::optional<int> out;
+    bool done = false;
+    AsyncPopInto(queue, out, done);
+    ASSERT_TRUE(done);  // 有元素时不挂起
+    ASSERT_EQ(7, out.value());
+}
+
+TEST_CASE(AsyncQueue_PopAsync_Suspends_Until_Push) {
+    AsyncQueue<int> queue(4);
+    std::optional<int> out;
+    bool done = false;
+    AsyncPopInto(queue, out, done);
+    ASSERT_FALSE(done);
+
+    // 元素直接交给挂起的消费者，不进入队列
+    ASSERT_TRUE(queue.TryPush(42));
+    ASSERT_TRUE(done);
+    ASSERT_EQ(42, out.value());
+    ASSERT_TRUE(queue.Empty());
+}
+
+TEST_CASE(AsyncQueue_PushAsync_Suspends_When_Full) {
+    AsyncQueue<int> queue(1);
+    ASSERT_TRUE(queue.TryPush(1));
+
+    bool ok = false;
+    bool done = false;
+    AsyncPushFrom(queue, 2, ok, done);
+    ASSERT_FALSE(done);
+
+    // 取走一个元素后挂起的生产者补上空位
+    ASSERT_EQ(1, queue.TryPop().value());
+    ASSERT_TRUE(done);
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(2, queue.TryPop().value());
+    ASSERT_FALSE(queue.TryPop().has_value());
+}
+
+TEST_CASE(AsyncQueue_Zero_Capacity_Rendezvous) {
+    AsyncQueue<int> queue(0);
+    ASSERT_FALSE(queue.TryPush(1));
+
+    bool ok = false;
+    bool done = false;
+    AsyncPushFrom(queue, 5, ok, done);
+    ASSERT_FALSE(done);
+    ASSERT_EQ(5, queue.TryPop().value());
+    ASSERT_TRUE(ok);
+
+    std::optional<int> out;
+    bool popped = false;
+    AsyncPopInto(queue, out, popped);
+    ASSERT_FALSE(popped);
+    ASSERT_TRUE(queue.TryPush(6));
+    ASSERT_EQ(6, out.value());
+}
+
+TEST_CASE(AsyncQueue_Close_Cancels_Waiters) {
+    AsyncQueue<int> queue(1);
+    std::optional<int> out1, out2;
+    bool done1 = false, done2 = false;
+    AsyncPopInto(queue, out1, done1);
+    AsyncPopInto(queue, out2, done2);
+
+    queue.Close();
+    ASSERT_TRUE(done1);
+    ASSERT_TRUE(done2);
+    ASSERT_FALSE(out1.has_value());
+    ASSERT_FALSE(out2.has_value());
+
+    // 关闭后 PushAsync 立即返回 false
+    bool ok = true;
+    bool done = false;
+    AsyncPushFrom(queue, 1, ok, done);
+    ASSERT_TRUE(done);
+    ASSERT_FALSE(ok);
+}
+
+TEST_CASE(AsyncQueue_Close_Cancels_Pushers_Keeps_Items) {
+    AsyncQueue<std::string> queue(1);
+    ASSERT_TRUE(queue.TryPush("kept"));
+
+    bool ok = true;
+    bool done = false;
+    [](AsyncQueue<std::string>& q, bool& ok, bool& done) -> AsyncQueueDetached {
+        ok = co_await q.PushAsync("dropped");
+        done = true;
+    }(queue, ok, done);
+    ASSERT_FALSE(done);
+
+    queue.Close();
+    ASSERT_TRUE(done);
+    ASSERT_FALSE(ok);
+    ASSERT_EQ(std::string("kept"), queue.TryPop().value());
+    ASSERT_FALSE(queue.TryPop().has_value());
+}
+
+TEST_CASE(AsyncQueue_Executor_Defers_Resume) {
+    std::vector<std::coroutine_handle<>> scheduled;
+    AsyncQueue<int> queue(4, [&scheduled](std::coroutine_handle<> h) { scheduled.push_back(h); });
+
+    std::optional<int> out;
+    bool done = false;
+    AsyncPopInto(queue, out, done);
+    ASSERT_TRUE(queue.TryPush(3));
+
+    // 唤醒只是把协程交给执行器，由执行器决定何时恢复
+    ASSERT_FALSE(done);
+    ASSERT_EQ(1, scheduled.size());
+    scheduled[0].resume();
+    ASSERT_TRUE(done);
+    ASSERT_EQ(3, out.value());
+}
+
+// ==================== 多线程测试 ====================
+
+static AsyncQueueDetached AsyncProduce(AsyncQueue<int>& queue, int count, std::atomic<int>& finished) {
+    for (int i = 1; i <= count; ++i) {
+        co_await queue.PushAsync(i);
+    }
+    finished.fetch_add(1);
+}
+
+static AsyncQueueDetached AsyncConsume(AsyncQueue<int>& queue, std::atomic<long long>& sum,
+                                       std::atomic<int>& finished) {
+    while (auto item = co_await queue.PopAsync()) {
+        sum.fetch_add(*item);
+    }
+    finished.fetch_add(1);
+}
+
+TEST_CASE(AsyncQueue_ThreadPool_Executor) {
+    const int num_producers = 4;
+    const int num_consumers = 3;
+    const int items_per_producer = 5000;
+
+    ThreadPool pool(4);
+    AsyncQueue<int> queue(16, [&pool](std::coroutine_handle<> h) { pool.Post(h); });
+    std::atomic<long long> sum{0};
+    std::atomic<int> producers_done{0};
+    std::atomic<int> consumers_done{0};
+
+    for (int c = 0; c < num_consumers; ++c) {
+        pool.Post([&] { AsyncConsume(queue, sum, consumers_done); });
+    }
+    for (int p = 0; p < num_producers; ++p) {
+        pool.Post([&] { AsyncProduce(queue, items_per_producer, producers_done); });
+    }
+
+    while (producers_done.load() < num_producers) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // 取完剩余元素后消费者因关闭而退出
+    while (!queue.Empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    queue.Close();
+    while (consumers_done.load() < num_consumers) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pool.Close();
+
+    ASSERT_EQ(static_cast<long long>(items_per_producer) * (items_per_producer + 1) / 2 * num_producers, sum.load());
+}
+
+void test_async_queue() { RUN_ALL_TESTS(); }
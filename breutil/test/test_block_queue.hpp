@@ -2,7 +2,11 @@
 
 #include <atomic>
 #include <chrono>
+#include <iterator>
+#include <memory>
+#include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "../block_queue.hpp"
@@ -118,6 +122,49 @@ TEST_CASE(BlockQueue_SetCapacity) {
     ASSERT_EQ(3, queue.Capacity());
 }
 
+TEST_CASE(BlockQueue_SetCapacity_Keeps_Items) {
+    BlockQueue<int> queue(4);
+
+    // 先让队首绕到存储中间，再调整容量
+    queue.TryPush(0);
+    queue.TryPush(0);
+    queue.TryPop();
+    queue.TryPop();
+    for (int i = 1; i <= 4; ++i) {
+        queue.TryPush(i);
+    }
+
+    // 缩容到小于当前元素个数，已有元素保持原顺序
+    queue.SetCapacity(2);
+    ASSERT_EQ(4, queue.Size());
+    ASSERT_FALSE(queue.TryPush(5));
+    ASSERT_EQ(1, queue.TryPop().value());
+    ASSERT_EQ(2, queue.TryPop().value());
+    ASSERT_FALSE(queue.TryPush(5));
+
+    queue.SetCapacity(8);
+    for (int i = 5; i <= 10; ++i) {
+        ASSERT_TRUE(queue.TryPush(i));
+    }
+    ASSERT_TRUE(queue.Full());
+    for (int i = 3; i <= 10; ++i) {
+        ASSERT_EQ(i, queue.TryPop().value());
+    }
+}
+
+TEST_CASE(BlockQueue_Wraparound) {
+    BlockQueue<std::string> queue(3);
+
+    for (int round = 0; round < 10; ++round) {
+        ASSERT_TRUE(queue.TryPush(std::to_string(round)));
+        ASSERT_TRUE(queue.TryPush(std::to_string(round + 100)));
+        ASSERT_EQ(std::to_string(round), queue.TryPop().value());
+        ASSERT_EQ(std::to_string(round + 100), queue.Back());
+        ASSERT_EQ(std::to_string(round + 100), queue.TryPop().value());
+    }
+    ASSERT_TRUE(queue.Empty());
+}
+
 // ==================== 阻塞操作测试 ====================
 
 TEST_CASE(BlockQueue_Push_Pop_Blocking) {
@@ -178,6 +225,83 @@ TEST_CASE(BlockQueue_Push_With_Timeout) {
     ASSERT_GE(elapsed.count(), std::chrono::milliseconds(90).count());
 }
 
+TEST_CASE(BlockQueue_PopUntil_Shared_Deadline) {
+    BlockQueue<int> queue(8);
+
+    // 生产者陆续放入 3 个元素，消费者用同一个截止时间循环取，取完后等到截止时间返回
+    std::thread producer([&queue]() {
+        for (int i = 1; i <= 3; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            queue.Push(i);
+        }
+    });
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::milliseconds(150);
+    int count = 0;
+    int value = 0;
+    while (queue.PopUntil(value, deadline)) {
+        ++count;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    producer.join();
+
+    ASSERT_EQ(3, count);
+    ASSERT_GE(elapsed, std::chrono::milliseconds(150));
+    ASSERT_LT(elapsed, std::chrono::milliseconds(1000));
+
+    // 截止时间已过时不等待
+    ASSERT_TRUE(queue.PushUntil(4, deadline));
+    ASSERT_EQ(4, queue.PopUntil(deadline).value());
+    ASSERT_FALSE(queue.PopUntil(deadline).has_value());
+    ASSERT_FALSE(queue.PeekUntil(value, deadline));
+}
+
+TEST_CASE(BlockQueue_Wait_Not_Extended_By_Wakeups) {
+    BlockQueue<int> queue(1);
+    std::atomic<bool> stop{false};
+
+    // 反复无效唤醒等待中的消费者
+    std::thread waker([&queue, &stop]() {
+        while (!stop.load()) {
+            queue.NotifyAll();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+    int value = 0;
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.PopUntil(value, start + std::chrono::milliseconds(50)));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    stop.store(true);
+    waker.join();
+
+    ASSERT_GE(elapsed, std::chrono::milliseconds(50));
+    ASSERT_LT(elapsed, std::chrono::milliseconds(500));
+}
+
+TEST_CASE(BlockQueue_Sub_Millisecond_And_Unbounded_Timeout) {
+    BlockQueue<int> queue(1);
+    int value = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.Pop(value, std::chrono::microseconds(300)));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_GE(elapsed, std::chrono::microseconds(300));
+    ASSERT_LT(elapsed, std::chrono::milliseconds(100));
+    ASSERT_FALSE(queue.Peek(value, std::chrono::duration<double, std::micro>(250.5)));
+
+    // 超出时钟表示范围的时长饱和为无限等待，不会溢出成立即超时
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.Push(9);
+    });
+    ASSERT_TRUE(queue.Pop(value, std::chrono::hours::max()));
+    ASSERT_EQ(9, value);
+    producer.join();
+
+    queue.Push(1);
+    ASSERT_FALSE(queue.Push(2, std::chrono::microseconds(100)));
+}
+
 TEST_CASE(BlockQueue_Peek) {
     BlockQueue<int> queue(5);
 
@@ -278,6 +402,97 @@ TEST_CASE(BlockQueue_PopBatch_Less_Than_Request) {
     ASSERT_TRUE(queue.Empty());
 }
 
+// ==================== 移动语义与原地构造测试 ====================
+
+TEST_CASE(BlockQueue_Emplace_MoveOnly) {
+    BlockQueue<std::unique_ptr<int>> queue(2);
+    queue.Emplace(new int(1));
+    ASSERT_TRUE(queue.TryEmplace(std::make_unique<int>(2)));
+
+    // 队列满时 TryEmplace 失败，参数不会被移走
+    auto extra = std::make_unique<int>(3);
+    ASSERT_FALSE(queue.TryEmplace(std::move(extra)));
+    ASSERT_NOT_NULL(extra.get());
+
+    auto first = queue.Pop();
+    ASSERT_TRUE(first.has_value());
+    ASSERT_EQ(1, **first);
+    ASSERT_EQ(2, *queue.TryPop().value());
+}
+
+TEST_CASE(BlockQueue_Emplace_Multiple_Args) {
+    BlockQueue<std::pair<int, std::string>> queue(4);
+    queue.Emplace(1, "one");
+    ASSERT_TRUE(queue.TryEmplace(2, std::string(3, 'x')));
+
+    ASSERT_TRUE(queue.Pop() == std::make_pair(1, std::string("one")));
+    ASSERT_TRUE(queue.Pop() == std::make_pair(2, std::string("xxx")));
+}
+
+TEST_CASE(BlockQueue_Pop_Optional_Blocks_Until_Close) {
+    BlockQueue<std::unique_ptr<int>> queue(4);
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.Push(std::make_unique<int>(7));
+        queue.Close();
+    });
+
+    auto item = queue.Pop();
+    ASSERT_TRUE(item.has_value());
+    ASSERT_EQ(7, **item);
+    ASSERT_FALSE(queue.Pop().has_value());  // 关闭且为空
+    producer.join();
+    ASSERT_THROW(queue.Emplace(std::make_unique<int>(8)), std::runtime_error);
+}
+
+TEST_CASE(BlockQueue_Batch_Push_Move_Iterator) {
+    BlockQueue<std::unique_ptr<int>> queue(3);
+    std::vector<std::unique_ptr<int>> items;
+    for (int i = 0; i < 5; ++i) {
+        items.push_back(std::make_unique<int>(i));
+    }
+
+    // 只能放下 3 个，其余保持原样
+    ASSERT_EQ(3, queue.Push(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end())));
+    ASSERT_NULL(items[0].get());
+    ASSERT_NULL(items[2].get());
+    ASSERT_NOT_NULL(items[3].get());
+    ASSERT_NOT_NULL(items[4].get());
+
+    std::vector<std::unique_ptr<int>> out;
+    ASSERT_EQ(3, queue.Pop(std::back_inserter(out), 10));
+    ASSERT_EQ(2, *out[2]);
+
+    // 能全部放下时一次加锁放入
+    ASSERT_EQ(2, queue.Push(std::make_move_iterator(items.begin() + 3), std::make_move_iterator(items.end())));
+    ASSERT_EQ(2, queue.Size());
+}
+
+TEST_CASE(BlockQueue_PeekWith) {
+    BlockQueue<std::unique_ptr<std::string>> queue(4);
+    int seen = 0;
+    ASSERT_FALSE(queue.PeekWith([&seen](const std::unique_ptr<std::string>&) { ++seen; }));
+    ASSERT_EQ(0, seen);
+
+    queue.Emplace(std::make_unique<std::string>("head"));
+    queue.Emplace(std::make_unique<std::string>("tail"));
+    std::string head;
+    ASSERT_TRUE(queue.PeekWith([&head](const std::unique_ptr<std::string>& item) { head = *item; }));
+    ASSERT_EQ(std::string("head"), head);
+    ASSERT_EQ(2, queue.Size());  // 不取出
+
+    // 队列为空时等待到超时
+    BlockQueue<int> empty(1);
+    std::thread producer([&empty]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        empty.Push(5);
+    });
+    int value = 0;
+    ASSERT_TRUE(empty.PeekWith([&value](const int& v) { value = v; }, 1000));
+    ASSERT_EQ(5, value);
+    producer.join();
+}
+
 // ==================== 多线程测试 ====================
 
 TEST_CASE(BlockQueue_MultiProducer_MultiConsumer) {
@@ -349,6 +564,46 @@ TEST_CASE(BlockQueue_ProducerConsumer_Pattern) {
     ASSERT_EQ(expected, sum);
 }
 
+TEST_CASE(BlockQueue_Observers_Concurrent_Snapshot) {
+    BlockQueue<int> queue(64);
+    std::atomic<bool> done{false};
+    std::atomic<int> out_of_range{0};
+
+    // 观测线程不加锁读取，快照始终落在 [0, 容量] 内
+    std::thread observer([&]() {
+        while (!done.load()) {
+            if (queue.Size() > queue.Capacity()) {
+                out_of_range.fetch_add(1);
+            }
+            (void)queue.Full();
+            (void)queue.IsClosed();
+        }
+    });
+    std::thread producer([&queue]() {
+        for (int i = 0; i < 20000; ++i) {
+            queue.Push(i);
+        }
+    });
+    int value = 0;
+    for (int i = 0; i < 20000; ++i) {
+        queue.Pop(value);
+    }
+    producer.join();
+    done.store(true);
+    observer.join();
+
+    ASSERT_EQ(0, out_of_range.load());
+    ASSERT_EQ(0, queue.Size());
+    ASSERT_TRUE(queue.Empty());
+
+    // 缩容到当前元素个数以下时 Full 立即为真
+    queue.TryPush(1);
+    queue.TryPush(2);
+    queue.SetCapacity(1);
+    ASSERT_TRUE(queue.Full());
+    ASSERT_EQ(1, queue.Capacity());
+}
+
 // ==================== 关闭功能测试 ====================
 
 TEST_CASE(BlockQueue_Close_Basic) {
@@ -521,4 +776,339 @@ TEST_CASE(BlockQueue_NotifyAll) {
     ASSERT_GE(woken_count, 1);
 }
 
+// ==================== 唤醒统计测试 ====================
+
+TEST_CASE(BlockQueue_No_Notify_Without_Waiters) {
+    BlockQueue<int> queue(100);
+
+    for (int i = 0; i < 50; ++i) {
+        queue.TryPush(i);
+    }
+    std::vector<int> items = {1, 2, 3};
+    queue.Push(items.begin(), items.end());
+    while (queue.TryPop()) {
+    }
+
+    auto stats = queue.GetWakeupStats();
+    ASSERT_EQ(0, stats.notifications);
+    ASSERT_EQ(0, stats.wakeups);
+    ASSERT_GT(stats.skippedNotifications, 50);
+}
+
+TEST_CASE(BlockQueue_Batch_Push_Wakes_Only_Needed) {
+    BlockQueue<int> queue(100);
+    const int num_consumers = 4;
+    std::atomic<int> popped{0};
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < num_consumers; ++i) {
+        consumers.emplace_back([&queue, &popped]() {
+            int val;
+            if (queue.Pop(val)) {
+                popped++;
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // 只放入 2 个元素，最多唤醒 2 个消费者
+    std::vector<int> items = {1, 2};
+    queue.Push(items.begin(), items.end());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(2, popped.load());
+    ASSERT_EQ(2, queue.GetWakeupStats().notifications);
+
+    queue.Close();
+    for (auto& t : consumers) t.join();
+    ASSERT_EQ(2, popped.load());
+}
+
+// ==================== 攒批操作测试 ====================
+
+TEST_CASE(BlockQueue_PopBatch_MinCount) {
+    BlockQueue<int> queue(100);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < 10; ++i) {
+            queue.Push(i);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+
+    // 至少 5 个才返回，最多 8 个
+    std::vector<int> results;
+    size_t count = queue.Pop(std::back_inserter(results), 5, 8, std::chrono::seconds(5));
+    ASSERT_GE(count, 5);
+    ASSERT_LE(count, 8);
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(static_cast<int>(i), results[i]);
+    }
+    producer.join();
+}
+
+TEST_CASE(BlockQueue_PopBatch_Timeout_Returns_Partial) {
+    BlockQueue<int> queue(100);
+    queue.TryPush(1);
+    queue.TryPush(2);
+
+    std::vector<int> results;
+    auto start = std::chrono::steady_clock::now();
+    size_t count = queue.Pop(std::back_inserter(results), 64, 512, std::chrono::milliseconds(50));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(2, count);
+    ASSERT_GE(elapsed.count(), std::chrono::milliseconds(45).count());
+
+    // 空队列超时返回 0
+    ASSERT_EQ(0, queue.Pop(std::back_inserter(results), 1, 10, std::chrono::milliseconds(10)));
+}
+
+TEST_CASE(BlockQueue_PopBatch_Close_Wakes) {
+    BlockQueue<int> queue(100);
+    queue.TryPush(1);
+
+    std::atomic<size_t> count{0};
+    std::thread consumer([&queue, &count]() {
+        std::vector<int> results;
+        count = queue.Pop(std::back_inserter(results), 10, 10, std::chrono::seconds(10));
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.Close();
+    consumer.join();
+    ASSERT_EQ(1, count.load());
+}
+
+TEST_CASE(BlockQueue_PushBatch_AllOrNothing) {
+    BlockQueue<int> queue(4);
+    queue.TryPush(0);
+    queue.TryPush(0);
+
+    // 只剩 2 个空位，放不下 3 个，超时后一个也不放
+    std::vector<int> items = {1, 2, 3};
+    ASSERT_EQ(0, queue.Push(items.begin(), items.end(), std::chrono::milliseconds(20)));
+    ASSERT_EQ(2, queue.Size());
+
+    // 超过容量的批次直接失败
+    std::vector<int> big(5, 1);
+    ASSERT_EQ(0, queue.Push(big.begin(), big.end(), std::chrono::seconds(10)));
+
+    // 消费者腾出空间后整体放入
+    std::thread consumer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.TryPop();
+    });
+    ASSERT_EQ(3, queue.Push(items.begin(), items.end(), std::chrono::seconds(5)));
+    consumer.join();
+    ASSERT_TRUE(queue.Full());
+}
+
+TEST_CASE(BlockQueue_PushBatch_Partial) {
+    BlockQueue<int> queue(4);
+    std::vector<int> items = {1, 2, 3, 4, 5, 6};
+
+    // 没有消费者：放满 4 个后超时
+    ASSERT_EQ(4, queue.Push(items.begin(), items.end(), std::chrono::milliseconds(20), BatchPush::Partial));
+
+    // 有消费者时全部放入
+    BlockQueue<int> queue2(4);
+    std::vector<int> results;
+    std::thread consumer([&queue2, &results]() {
+        int val;
+        while (queue2.Pop(val)) {
+            results.push_back(val);
+        }
+    });
+    ASSERT_EQ(6, queue2.Push(items.begin(), items.end(), std::chrono::seconds(5), BatchPush::Partial));
+    while (!queue2.Empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    queue2.Close();
+    consumer.join();
+    ASSERT_EQ(6, results.size());
+    ASSERT_EQ(6, results.back());
+}
+
+TEST_CASE(BlockQueue_DrainAll_Container) {
+    BlockQueue<std::string> queue(4);
+    std::vector<std::string> out;
+    ASSERT_EQ(0, queue.DrainAll(out));
+
+    // 先让队首绕到存储中间，取出的顺序不变
+    queue.Push("x");
+    queue.TryPop();
+    for (int i = 1; i <= 4; ++i) {
+        queue.Push(std::to_string(i));
+    }
+    out.push_back("0");
+    ASSERT_EQ(4, queue.DrainAll(out));
+    ASSERT_TRUE(queue.Empty());
+    ASSERT_EQ(5, out.size());
+    for (int i = 0; i <= 4; ++i) {
+        ASSERT_EQ(std::to_string(i), out[i]);
+    }
+
+    // 换入的存储可以继续放满
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.TryPush("y"));
+    }
+    ASSERT_FALSE(queue.TryPush("z"));
+}
+
+TEST_CASE(BlockQueue_DrainAll_RingBuffer_Swap) {
+    BlockQueue<std::unique_ptr<int>> queue(3);
+    RingBuffer<std::unique_ptr<int>> out;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            queue.Emplace(std::make_unique<int>(round * 10 + i));
+        }
+        ASSERT_EQ(3, queue.DrainAll(out));
+        ASSERT_EQ(3, out.Size());
+        ASSERT_EQ(round * 10, *out.Front());
+        ASSERT_EQ(round * 10 + 2, *out.Back());
+        out.Clear();  // 清空后存储再换回给队列
+    }
+
+    // out 非空时追加在原有元素之后
+    out.PushBack(std::make_unique<int>(-1));
+    queue.Emplace(std::make_unique<int>(100));
+    queue.Emplace(std::make_unique<int>(101));
+    ASSERT_EQ(2, queue.DrainAll(out));
+    ASSERT_EQ(3, out.Size());
+    ASSERT_EQ(-1, *out[0]);
+    ASSERT_EQ(101, *out[2]);
+    ASSERT_TRUE(queue.Empty());
+}
+
+TEST_CASE(BlockQueue_DrainAll_Wakes_Producers) {
+    const int num_producers = 4;
+    const int items_per_producer = 5000;
+    BlockQueue<int> queue(64);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue]() {
+            for (int i = 1; i <= items_per_producer; ++i) {
+                queue.Push(i);
+            }
+        });
+    }
+    std::thread closer([&]() {
+        for (auto& t : producers) t.join();
+        queue.Close();
+    });
+
+    // 队列满时生产者阻塞，DrainAll 腾出空间后应唤醒它们
+    long long sum = 0;
+    std::vector<int> batch;
+    while (!queue.IsClosed() || !queue.Empty()) {
+        batch.clear();
+        if (queue.DrainAll(batch) == 0) {
+            std::this_thread::yield();
+        }
+        for (int v : batch) {
+            sum += v;
+        }
+    }
+    closer.join();
+    ASSERT_EQ(static_cast<long long>(items_per_producer) * (items_per_producer + 1) / 2 * num_producers, sum);
+}
+
+// ==================== 等待策略测试 ====================
+
+TEST_CASE(BlockQueue_WaitStrategy_ProducerConsumer) {
+    for (auto strategy : {WaitStrategy::Block, WaitStrategy::YieldThenBlock, WaitStrategy::SpinThenBlock}) {
+        BlockQueue<int> queue(4, strategy);
+        ASSERT_TRUE(queue.GetWaitStrategy() == strategy);
+        const int count = 10000;
+
+        std::thread producer([&queue]() {
+            for (int i = 0; i < count; ++i) {
+                queue.Push(i);
+            }
+            queue.Close();
+        });
+
+        int expected = 0;
+        int val;
+        bool ordered = true;
+        while (queue.Pop(val)) {
+            ordered = ordered && val == expected;
+            ++expected;
+        }
+        producer.join();
+        ASSERT_TRUE(ordered);
+        ASSERT_EQ(count, expected);
+    }
+}
+
+TEST_CASE(BlockQueue_SpinThenBlock_Timeout_And_Close) {
+    BlockQueue<int> queue(1, WaitStrategy::SpinThenBlock);
+
+    int val;
+    ASSERT_FALSE(queue.Pop(val, 50));
+    queue.TryPush(1);
+    ASSERT_FALSE(queue.Push(2, std::chrono::milliseconds(50)));
+
+    std::thread consumer([&queue]() {
+        int v;
+        while (queue.Pop(v)) {
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.Close();
+    consumer.join();
+    ASSERT_TRUE(queue.Empty());
+}
+
+// 截止时间已过或很近时，自旋不能先把自适应预算耗完再去看截止时间
+TEST_CASE(BlockQueue_SpinThenBlock_Respects_Deadline) {
+    AdaptiveSpin spin;
+    const uint32_t budget = spin.Budget();
+    int polls = 0;
+    ASSERT_FALSE(spin.Spin(
+        [&polls] {
+            ++polls;
+            return false;
+        },
+        std::chrono::steady_clock::now() - std::chrono::milliseconds(1)));
+    ASSERT_EQ(1, polls);
+    ASSERT_EQ(budget, spin.Budget());
+
+    BlockQueue<int> queue(1, WaitStrategy::SpinThenBlock);
+    int val;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.PopUntil(val, start - std::chrono::seconds(1)));
+    ASSERT_FALSE(queue.Pop(val, std::chrono::microseconds(200)));
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+    queue.TryPush(1);
+    ASSERT_FALSE(queue.PushUntil(2, std::chrono::steady_clock::now()));
+}
+
+TEST_CASE(AdaptiveSpin_Budget) {
+    AdaptiveSpin spin;
+    const uint32_t initial = spin.Budget();
+
+    // 挂起很久：自旋是浪费，预算回落到最小值
+    for (int i = 0; i < 32; ++i) {
+        spin.Parked(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(AdaptiveSpin::kMinSpins, spin.Budget());
+
+    // 挂起时间短：加大预算，但不超过上限
+    for (int i = 0; i < 32; ++i) {
+        spin.Parked(std::chrono::microseconds(50));
+    }
+    ASSERT_GT(spin.Budget(), initial);
+    ASSERT_LE(spin.Budget(), AdaptiveSpin::kMaxSpins);
+
+    // 立刻等到时预算收缩
+    const uint32_t before = spin.Budget();
+    ASSERT_TRUE(spin.Spin([] {
+        return true;
+    }));
+    ASSERT_LT(spin.Budget(), before);
+}
+
 void test_block_queue() { RUN_ALL_TESTS(); }
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../broadcast_ring.hpp"
+#include "../easy_test.hpp"
+
+using namespace bre;
+
+// ==================== 基础功能测试 ====================
+
+TEST_CASE(BroadcastRing_Every_Subscriber_Sees_Every_Event) {
+    BroadcastRing<std::string, 4> ring;
+    auto first = ring.Subscribe();
+    auto second = ring.Subscribe();
+
+    ASSERT_TRUE(ring.TryPublish("a"));
+    ASSERT_TRUE(ring.TryPublish("b"));
+    ASSERT_TRUE(ring.TryEmplace(3, 'c'));
+    ASSERT_EQ(3, ring.Published());
+    ASSERT_EQ(3, first.Lag());
+
+    std::vector<std::string> seen1, seen2;
+    ASSERT_EQ(3, first.TryPoll([&seen1](const std::string& s) { seen1.push_back(s); }));
+    ASSERT_EQ(2, second.TryPoll([&seen2](const std::string& s) { seen2.push_back(s); }, 2));
+    ASSERT_EQ(1, second.TryPoll([&seen2](const std::string& s) { seen2.push_back(s); }));
+    ASSERT_EQ(0, first.TryPoll([&seen1](const std::string& s) { seen1.push_back(s); }));
+
+    ASSERT_EQ(3, seen1.size());
+    ASSERT_EQ(std::string("ccc"), seen1[2]);
+    ASSERT_EQ(seen1, seen2);
+    ASSERT_EQ(3, first.Sequence());
+    ASSERT_EQ(0, second.Lag());
+}
+
+TEST_CASE(BroadcastRing_Producer_Gated_By_Slowest) {
+    BroadcastRing<int, 4> ring;
+    auto fast = ring.Subscribe();
+    auto slow = ring.Subscribe();
+    auto ignore = [](const int&) {};
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.TryPublish(i));
+    }
+    fast.TryPoll(ignore);
+    ASSERT_FALSE(ring.TryPublish(4));  // slow 还没读第 0 个
+
+    int value = -1;
+    ASSERT_EQ(1, slow.TryPoll([&value](const int& v) { value = v; }, 1));
+    ASSERT_EQ(0, value);
+    ASSERT_TRUE(ring.TryPublish(4));
+    ASSERT_FALSE(ring.TryPublish(5));
+
+    // 退订后不再拖住生产者
+    slow.Unsubscribe();
+    ASSERT_TRUE(ring.TryPublish(5));
+    ASSERT_EQ(2, fast.TryPoll(ignore));
+}
+
+TEST_CASE(BroadcastRing_No_Subscribers_Overwrites) {
+    BroadcastRing<int, 4> ring;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(ring.TryPublish(i));
+    }
+
+    // 之后加入的订阅者从最新位置开始
+    auto late = ring.Subscribe();
+    ASSERT_EQ(100, late.Sequence());
+    ASSERT_EQ(0, late.Lag());
+    ring.Publish(100);
+    int value = -1;
+    ASSERT_EQ(1, late.TryPoll([&value](const int& v) { value = v; }));
+    ASSERT_EQ(100, value);
+}
+
+TEST_CASE(BroadcastRing_Batch_Publish) {
+    BroadcastRing<int, 8> ring;
+    auto sub = ring.Subscribe();
+    std::vector<int> input{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    ASSERT_EQ(8, ring.TryPublish(input.begin(), input.end()));
+
+    std::vector<int> out;
+    ASSERT_EQ(8, sub.TryPoll([&out](const int& v) { out.push_back(v); }));
+    ASSERT_EQ(2, ring.TryPublish(input.begin() + 8, input.end()));
+    ASSERT_EQ(2, sub.TryPoll([&out](const int& v) { out.push_back(v); }));
+    ASSERT_EQ(input, out);
+}
+
+TEST_CASE(BroadcastRing_Subscriber_Limit) {
+    BroadcastRing<int, 4> ring(2);
+    auto a = ring.Subscribe();
+    {
+        auto b = ring.Subscribe();
+        ASSERT_THROW(ring.Subscribe(), std::runtime_error);
+    }
+    // 析构即退订，位置可以复用
+    auto c = std::move(a);
+    auto d = ring.Subscribe();
+    ASSERT_TRUE(ring.TryPublish(1));
+    ASSERT_EQ(1, c.Lag());
+    ASSERT_EQ(1, d.Lag());
+}
+
+TEST_CASE(BroadcastRing_Handler_Exception_Keeps_Progress) {
+    BroadcastRing<int, 8> ring;
+    auto sub = ring.Subscribe();
+    for (int i = 0; i < 5; ++i) {
+        ring.Publish(i);
+    }
+    ASSERT_THROW(sub.TryPoll([](const int& v) {
+        if (v == 2) throw std::runtime_error("bad event");
+    }),
+                 std::runtime_error);
+    ASSERT_EQ(2, sub.Sequence());  // 0、1 已处理，下次从抛出异常的事件重试
+}
+
+TEST_CASE(BroadcastRing_Destructor_Releases_Items) {
+    auto tracker = std::make_shared<int>(0);
+    {
+        BroadcastRing<std::shared_ptr<int>, 4> ring;
+        for (int i = 0; i < 6; ++i) {
+            ring.Publish(tracker);
+        }
+        ASSERT_EQ(5, tracker.use_count());  // 环中只保留最近的 4 个
+    }
+    ASSERT_EQ(1, tracker.use_count());
+}
+
+// 构造时可能抛出异常、统计存活实例数的事件类型
+struct BroadcastRingTracked {
+    static inline int live = 0;
+
+    explicit BroadcastRingTracked(int v) : value(v) {
+        if (v < 0) throw std::runtime_error("rejected");
+        ++live;
+    }
+    BroadcastRingTracked(const BroadcastRingTracked& other) : BroadcastRingTracked(other.value) {}
+    ~BroadcastRingTracked() { --live; }
+
+    int value;
+};
+
+TEST_CASE(BroadcastRing_Throwing_Constructor) {
+    BroadcastRingTracked::live = 0;
+    {
+        BroadcastRing<BroadcastRingTracked, 2> ring;
+        auto sub = ring.Subscribe();
+        std::vector<int> seen;
+        auto collect = [&seen](const BroadcastRingTracked& e) { seen.push_back(e.value); };
+
+        // 第二圈覆盖旧事件时构造失败：旧事件已析构，槽位为空，序号不前进
+        ASSERT_TRUE(ring.TryEmplace(1));
+        ASSERT_TRUE(ring.TryEmplace(2));
+        sub.TryPoll(collect);
+        ASSERT_THROW(ring.TryEmplace(-1), std::runtime_error);
+        ASSERT_EQ(2, ring.Published());
+        ASSERT_EQ(1, BroadcastRingTracked::live);
+
+        // 同一个槽位之后还能正常写入
+        ASSERT_TRUE(ring.TryEmplace(3));
+        sub.TryPoll(collect);
+
+        // 批量发布中途失败：之前构造好的照常发布
+        std::vector<int> batch{4, -1, 5};
+        ASSERT_THROW(ring.TryPublish(batch.begin(), batch.end()), std::runtime_error);
+        ASSERT_EQ(4, ring.Published());
+        sub.TryPoll(collect);
+        ASSERT_EQ((std::vector<int>{1, 2, 3, 4}), seen);
+    }
+    ASSERT_EQ(0, BroadcastRingTracked::live);
+
+    // 第一圈内构造失败也不能留下待析构的空槽位
+    {
+        BroadcastRing<BroadcastRingTracked, 4> ring;
+        std::vector<int> batch{1, 2, -1};
+        ASSERT_THROW(ring.TryPublish(batch.begin(), batch.end()), std::runtime_error);
+        ASSERT_EQ(2, ring.Published());
+        ASSERT_EQ(2, BroadcastRingTracked::live);
+    }
+    ASSERT_EQ(0, BroadcastRingTracked::live);
+}
+
+// ==================== 关闭功能测试 ====================
+
+TEST_CASE(BroadcastRing_Close) {
+    BroadcastRing<int, 4> ring;
+    auto sub = ring.Subscribe();
+    ring.Publish(1);
+    ring.Close();
+
+    ASSERT_TRUE(ring.IsClosed());
+    ASSERT_FALSE(ring.TryPublish(2));
+    ASSERT_THROW(ring.Publish(3), std::runtime_error);
+
+    // 读完剩余事件后 Poll 返回 0
+    int value = 0;
+    ASSERT_EQ(1, sub.Poll([&value](const int& v) { value = v; }));
+    ASSERT_EQ(1, value);
+    ASSERT_EQ(0, sub.Poll([&value](const int& v) { value = v; }));
+}
+
+TEST_CASE(BroadcastRing_Close_Wakes_Both_Sides) {
+    BroadcastRing<int, 2> ring;
+    auto idle = ring.Subscribe();
+    std::atomic<bool> poll_returned{false};
+    std::thread consumer([&ring, &poll_returned]() {
+        auto sub = ring.Subscribe();
+        while (sub.Poll([](const int&) {}) > 0) {
+        }
+        poll_returned = true;
+    });
+
+    // idle 不读，生产者填满两个槽位后阻塞
+    std::atomic<bool> threw{false};
+    std::thread producer([&ring, &threw]() {
+        try {
+            for (int i = 0;; ++i) {
+                ring.Publish(i);
+            }
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(threw);
+    ring.Close();
+    producer.join();
+    consumer.join();
+    ASSERT_TRUE(threw);
+    ASSERT_TRUE(poll_returned);
+}
+
+// ==================== 多线程测试 ====================
+
+template <bool Blocking>
+static void RunBroadcastFanOut() {
+    const int num_subscribers = 4;
+    const int count = 100000;
+    BroadcastRing<int, 64, Blocking> ring;
+
+    // 先订阅再开始发布，保证每个订阅者看到全部事件
+    std::vector<typename BroadcastRing<int, 64, Blocking>::Subscriber> subs;
+    for (int s = 0; s < num_subscribers; ++s) {
+        subs.push_back(ring.Subscribe());
+    }
+    std::vector<long long> sums(num_subscribers, 0);
+    std::vector<int> ordered(num_subscribers, 1);
+    std::vector<std::thread> consumers;
+    for (int s = 0; s < num_subscribers; ++s) {
+        consumers.emplace_back([&, s]() {
+            int expected = 0;
+            while (subs[s].Poll([&](const int& v) {
+                ordered[s] &= v == expected++;
+                sums[s] += v;
+            }) > 0) {
+            }
+        });
+    }
+
+    for (int i = 0; i < count; ++i) {
+        ring.Publish(i);
+    }
+    ring.Close();
+    for (auto& t : consumers) t.join();
+
+    bool all_ok = true;
+    for (int s = 0; s < num_subscribers; ++s) {
+        all_ok = all_ok && ordered[s] && sums[s] == static_cast<long long>(count) * (count - 1) / 2;
+    }
+    ASSERT_TRUE(all_ok);
+}
+
+TEST_CASE(BroadcastRing_FanOut_Blocking) {
+    RunBroadcastFanOut<true>();
+}
+
+TEST_CASE(BroadcastRing_FanOut_Spinning) {
+    RunBroadcastFanOut<false>();
+}
+
+TEST_CASE(BroadcastRing_Subscribe_While_Publishing) {
+    const int count = 50000;
+    BroadcastRing<int, 16> ring;
+    auto anchor = ring.Subscribe();
+
+    // 中途加入的订阅者看到的是从加入位置开始的连续序列
+    std::atomic<bool> contiguous{true};
+    std::thread joiner([&ring, &contiguous]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        auto sub = ring.Subscribe();
+        int expected = static_cast<int>(sub.Sequence());
+        while (sub.Poll([&](const int& v) {
+            if (v != expected++) contiguous = false;
+        }) > 0) {
+        }
+    });
+    std::thread producer([&ring]() {
+        for (int i = 0; i < count; ++i) {
+            ring.Publish(i);
+        }
+        ring.Close();
+    });
+
+    int received = 0;
+    while (anchor.Poll([&received](const int&) { ++received; }) > 0) {
+    }
+    producer.join();
+    joiner.join();
+    ASSERT_EQ(count, received);
+    ASSERT_TRUE(contiguous.load());
+}
+
+void test_broadcast_ring() { RUN_ALL_TESTS(); }
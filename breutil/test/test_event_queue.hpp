@@ -0,0 +1,166 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../easy_test.hpp"
+#include "../event_queue.hpp"
+
+using namespace bre;
+
+// 不阻塞地检查描述符是否可读
+static bool EventQueueReadable(int fd) {
+    pollfd pfd{fd, POLLIN, 0};
+    return ::poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN);
+}
+
+// ==================== 基础功能测试 ====================
+
+TEST_CASE(EventQueue_Fd_Tracks_NonEmpty) {
+    EventQueue<int> queue(16);
+    ASSERT_GE(queue.Fd(), 0);
+    ASSERT_FALSE(EventQueueReadable(queue.Fd()));
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(queue.TryPush(i));
+    }
+    ASSERT_TRUE(EventQueueReadable(queue.Fd()));
+
+    std::vector<int> items;
+    ASSERT_EQ(10, queue.TryPopAll(std::back_inserter(items)));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(i, items[i]);
+    }
+    ASSERT_TRUE(queue.Empty());
+    ASSERT_FALSE(EventQueueReadable(queue.Fd()));
+    ASSERT_EQ(0, queue.TryPopAll(std::back_inserter(items)));
+}
+
+TEST_CASE(EventQueue_TryPop_Clears_When_Empty) {
+    EventQueue<std::string> queue(4);
+    queue.Push("a");
+    queue.Push("b");
+
+    ASSERT_EQ(std::string("a"), queue.TryPop().value());
+    ASSERT_TRUE(EventQueueReadable(queue.Fd()));
+    ASSERT_EQ(std::string("b"), queue.TryPop().value());
+    ASSERT_FALSE(EventQueueReadable(queue.Fd()));
+    ASSERT_FALSE(queue.TryPop().has_value());
+}
+
+TEST_CASE(EventQueue_Batch_TryPush) {
+    EventQueue<int> queue(5);
+    std::vector<int> input{1, 2, 3, 4, 5, 6, 7};
+    ASSERT_EQ(5, queue.TryPush(input.begin(), input.end()));
+    ASSERT_TRUE(queue.Full());
+    ASSERT_FALSE(queue.TryPush(8));
+    ASSERT_TRUE(EventQueueReadable(queue.Fd()));
+
+    // 一次 read 即清空计数：批量写入只写了一次 eventfd
+    std::vector<int> items;
+    queue.TryPopAll(std::back_inserter(items));
+    ASSERT_EQ(5, items.size());
+    ASSERT_FALSE(EventQueueReadable(queue.Fd()));
+}
+
+TEST_CASE(EventQueue_Close) {
+    EventQueue<int> queue(4);
+    ASSERT_TRUE(queue.TryPush(1));
+    queue.Close();
+    ASSERT_TRUE(queue.IsClosed());
+    ASSERT_FALSE(queue.TryPush(2));
+    ASSERT_THROW(queue.Push(3), std::runtime_error);
+
+    // 关闭后取完剩余元素，描述符仍然可读，事件循环可以据此退出
+    std::vector<int> items;
+    ASSERT_EQ(1, queue.TryPopAll(std::back_inserter(items)));
+    ASSERT_TRUE(EventQueueReadable(queue.Fd()));
+}
+
+TEST_CASE(EventQueue_Blocking_Push_Unblocked_By_Drain) {
+    EventQueue<int> queue(2);
+    queue.Push(1);
+    queue.Push(2);
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&queue, &pushed]() {
+        queue.Push(3);
+        pushed.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(pushed.load());
+
+    std::vector<int> items;
+    queue.TryPopAll(std::back_inserter(items));
+    producer.join();
+    ASSERT_TRUE(pushed.load());
+    ASSERT_EQ(3, queue.TryPop().value());
+}
+
+// ==================== epoll 集成 ====================
+
+TEST_CASE(EventQueue_Epoll_Reactor) {
+    const int num_producers = 4;
+    const int items_per_producer = 20000;
+    EventQueue<int> queue(256);
+
+    const int epfd = ::epoll_create1(EPOLL_CLOEXEC);
+    ASSERT_GE(epfd, 0);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = queue.Fd();
+    ASSERT_EQ(0, ::epoll_ctl(epfd, EPOLL_CTL_ADD, queue.Fd(), &ev));
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue]() {
+            for (int i = 1; i <= items_per_producer; ++i) {
+                queue.Push(i);
+            }
+        });
+    }
+    std::thread closer([&]() {
+        for (auto& t : producers) t.join();
+        queue.Close();
+    });
+
+    // 事件循环：等待可读，一次取走一批，直到关闭且取空
+    long long sum = 0;
+    int count = 0;
+    int wakeups = 0;
+    std::vector<int> batch;
+    for (;;) {
+        epoll_event out{};
+        const int n = ::epoll_wait(epfd, &out, 1, 1000);
+        ASSERT_EQ(1, n);
+        ++wakeups;
+        batch.clear();
+        queue.TryPopAll(std::back_inserter(batch));
+        for (int v : batch) {
+            sum += v;
+        }
+        count += static_cast<int>(batch.size());
+        if (queue.IsClosed() && queue.Empty()) {
+            break;
+        }
+    }
+    closer.join();
+    ::close(epfd);
+
+    ASSERT_EQ(num_producers * items_per_producer, count);
+    ASSERT_EQ(static_cast<long long>(items_per_producer) * (items_per_producer + 1) / 2 * num_producers, sum);
+    ASSERT_LE(wakeups, count);
+}
+
+void test_event_queue() { RUN_ALL_TESTS(); }
+
+#endif  // __linux__
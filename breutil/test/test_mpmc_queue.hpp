@@ -0,0 +1,223 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../easy_test.hpp"
+#include "../mpmc_queue.hpp"
+
+using namespace bre;
+
+// ==================== 基础功能测试 ====================
+
+TEST_CASE(MpmcQueue_Capacity_Rounded) {
+    MpmcQueue<int> queue1;
+    ASSERT_EQ(1024, queue1.Capacity());
+    ASSERT_TRUE(queue1.Empty());
+    ASSERT_FALSE(queue1.IsClosed());
+
+    // 容量向上取整到 2 的幂
+    MpmcQueue<int> queue2(100);
+    ASSERT_EQ(128, queue2.Capacity());
+}
+
+TEST_CASE(MpmcQueue_TryPush_TryPop) {
+    MpmcQueue<int> queue(4);
+
+    ASSERT_TRUE(queue.TryPush(1));
+    ASSERT_TRUE(queue.TryPush(2));
+    ASSERT_TRUE(queue.TryPush(3));
+    ASSERT_EQ(3, queue.Size());
+
+    auto val = queue.TryPop();
+    ASSERT_TRUE(val.has_value());
+    ASSERT_EQ(1, val.value());
+    ASSERT_EQ(2, queue.TryPop().value());
+    ASSERT_EQ(3, queue.TryPop().value());
+    ASSERT_FALSE(queue.TryPop().has_value());
+}
+
+TEST_CASE(MpmcQueue_TryPush_Full) {
+    MpmcQueue<int> queue(2);
+
+    ASSERT_TRUE(queue.TryPush(1));
+    ASSERT_TRUE(queue.TryPush(2));
+    ASSERT_TRUE(queue.Full());
+    ASSERT_FALSE(queue.TryPush(3));
+
+    // 环绕之后仍保持 FIFO
+    ASSERT_EQ(1, queue.TryPop().value());
+    ASSERT_TRUE(queue.TryPush(3));
+    ASSERT_EQ(2, queue.TryPop().value());
+    ASSERT_EQ(3, queue.TryPop().value());
+}
+
+TEST_CASE(MpmcQueue_MoveOnly_Type) {
+    MpmcQueue<std::unique_ptr<std::string>> queue(4);
+
+    auto str = std::make_unique<std::string>("Hello");
+    ASSERT_TRUE(queue.TryPush(std::move(str)));
+    ASSERT_NULL(str.get());
+
+    // 满时 TryPush 失败，不移走参数
+    MpmcQueue<std::unique_ptr<int>> full(2);
+    full.TryPush(std::make_unique<int>(1));
+    full.TryPush(std::make_unique<int>(2));
+    auto keep = std::make_unique<int>(3);
+    ASSERT_FALSE(full.TryPush(std::move(keep)));
+    ASSERT_NOT_NULL(keep.get());
+
+    auto result = queue.TryPop();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(std::string("Hello"), **result);
+}
+
+// ==================== 阻塞与超时测试 ====================
+
+TEST_CASE(MpmcQueue_Pop_With_Timeout) {
+    MpmcQueue<int> queue(4);
+
+    int val;
+    auto start = std::chrono::steady_clock::now();
+    bool result = queue.Pop(val, 100);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_FALSE(result);
+    ASSERT_GE(elapsed.count(), std::chrono::milliseconds(90).count());
+}
+
+TEST_CASE(MpmcQueue_Push_With_Timeout) {
+    MpmcQueue<int> queue(2);
+    queue.TryPush(1);
+    queue.TryPush(2);
+
+    auto start = std::chrono::steady_clock::now();
+    bool result = queue.Push(3, std::chrono::milliseconds(100));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_FALSE(result);
+    ASSERT_GE(elapsed.count(), std::chrono::milliseconds(90).count());
+}
+
+TEST_CASE(MpmcQueue_Push_Unbounded_Timeout) {
+    MpmcQueue<int> queue(2);
+    queue.TryPush(1);
+    queue.TryPush(2);
+
+    // 超出时钟表示范围的时长饱和为无限等待，不会溢出成立即超时
+    std::thread consumer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.TryPop();
+    });
+    ASSERT_TRUE(queue.Push(3, std::chrono::hours::max()));
+    consumer.join();
+    ASSERT_FALSE(queue.Push(4, std::chrono::nanoseconds(-1)));
+}
+
+TEST_CASE(MpmcQueue_Blocking_Push_Pop) {
+    MpmcQueue<int> queue(2);
+
+    std::thread producer([&queue]() {
+        for (int i = 1; i <= 100; ++i) {
+            queue.Push(i);
+        }
+    });
+
+    for (int i = 1; i <= 100; ++i) {
+        int val = 0;
+        ASSERT_TRUE(queue.Pop(val));
+        ASSERT_EQ(i, val);
+    }
+    producer.join();
+}
+
+// ==================== 关闭功能测试 ====================
+
+TEST_CASE(MpmcQueue_Close) {
+    MpmcQueue<int> queue(4);
+    queue.TryPush(1);
+    queue.Close();
+
+    ASSERT_TRUE(queue.IsClosed());
+    ASSERT_FALSE(queue.TryPush(2));
+    ASSERT_THROW(queue.Push(3), std::runtime_error);
+
+    // 关闭后仍可取出剩余元素，取完返回 false
+    int val = 0;
+    ASSERT_TRUE(queue.Pop(val));
+    ASSERT_EQ(1, val);
+    ASSERT_FALSE(queue.Pop(val));
+}
+
+TEST_CASE(MpmcQueue_Close_Wakes_Waiting_Threads) {
+    MpmcQueue<int> queue(4);
+
+    std::atomic<bool> pop_returned{false};
+    std::thread consumer([&queue, &pop_returned]() {
+        int val;
+        bool result = queue.Pop(val);
+        ASSERT_FALSE(result);
+        pop_returned = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    queue.Close();
+    consumer.join();
+    ASSERT_TRUE(pop_returned);
+}
+
+// ==================== 多线程测试 ====================
+
+TEST_CASE(MpmcQueue_MultiProducer_MultiConsumer) {
+    MpmcQueue<int> queue(64);
+    const int items_per_producer = 20000;
+    const int num_producers = 4;
+    const int num_consumers = 4;
+    std::atomic<long long> sum{0};
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue]() {
+            for (int i = 1; i <= items_per_producer; ++i) {
+                queue.Push(i);
+            }
+        });
+    }
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < num_consumers; ++c) {
+        consumers.emplace_back([&queue, &sum, &consumed]() {
+            int val;
+            while (queue.Pop(val)) {
+                sum += val;
+                consumed++;
+            }
+        });
+    }
+
+    for (auto& t : producers) t.join();
+    queue.Close();
+    for (auto& t : consumers) t.join();
+
+    const long long expected = static_cast<long long>(items_per_producer) * (items_per_producer + 1) / 2 * num_producers;
+    ASSERT_EQ(items_per_producer * num_producers, consumed.load());
+    ASSERT_EQ(expected, sum.load());
+}
+
+TEST_CASE(MpmcQueue_Destructor_Releases_Items) {
+    auto tracker = std::make_shared<int>(0);
+    {
+        MpmcQueue<std::shared_ptr<int>> queue(8);
+        queue.TryPush(tracker);
+        queue.TryPush(tracker);
+        ASSERT_EQ(3, tracker.use_count());
+    }
+    ASSERT_EQ(1, tracker.use_count());
+}
+
+void test_mpmc_queue() { RUN_ALL_TESTS(); }
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../easy_test.hpp"
+#include "../priority_block_queue.hpp"
+
+using namespace bre;
+
+// ==================== PriorityBlockQueue ====================
+
+TEST_CASE(PriorityBlockQueue_Order) {
+    PriorityBlockQueue<int> queue(10);
+    for (int v : {3, 1, 4, 1, 5, 9, 2, 6}) {
+        ASSERT_TRUE(queue.TryPush(v));
+    }
+    ASSERT_EQ(9, queue.Top());
+
+    std::vector<int> results;
+    while (auto v = queue.TryPop()) {
+        results.push_back(*v);
+    }
+    std::vector<int> expected = {9, 6, 5, 4, 3, 2, 1, 1};
+    ASSERT_TRUE(results == expected);
+}
+
+TEST_CASE(PriorityBlockQueue_Custom_Compare_Stable) {
+    // 按 first 升序出队，first 相同时保持入队顺序
+    using Item = std::pair<int, std::string>;
+    auto cmp = [](const Item& a, const Item& b) {
+        return a.first > b.first;
+    };
+    PriorityBlockQueue<Item, decltype(cmp)> queue(10, cmp);
+
+    queue.TryPush({2, "a"});
+    queue.TryPush({1, "b"});
+    queue.TryPush({2, "c"});
+    queue.TryPush({1, "d"});
+    queue.TryPush({2, "e"});
+
+    std::vector<std::string> results;
+    Item item;
+    while (queue.Pop(item, 0)) {
+        results.push_back(item.second);
+    }
+    std::vector<std::string> expected = {"b", "d", "a", "c", "e"};
+    ASSERT_TRUE(results == expected);
+}
+
+TEST_CASE(PriorityBlockQueue_Full_And_Timeout) {
+    PriorityBlockQueue<int> queue(2);
+    ASSERT_TRUE(queue.TryPush(1));
+    ASSERT_TRUE(queue.TryPush(2));
+    ASSERT_TRUE(queue.Full());
+    ASSERT_FALSE(queue.TryPush(3));
+    ASSERT_FALSE(queue.Push(3, std::chrono::milliseconds(20)));
+
+    queue.TryPop();
+    queue.TryPop();
+    int val;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.Pop(val, 50));
+    ASSERT_GE((std::chrono::steady_clock::now() - start).count(), std::chrono::milliseconds(45).count());
+}
+
+TEST_CASE(PriorityBlockQueue_Unbounded_Timeout) {
+    PriorityBlockQueue<int> queue(1);
+    queue.TryPush(1);
+
+    // 超出时钟表示范围的时长饱和为无限等待，不会溢出成立即超时
+    std::thread consumer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.TryPop();
+    });
+    ASSERT_TRUE(queue.Push(2, std::chrono::hours::max()));
+    consumer.join();
+    ASSERT_EQ(2, queue.TryPop().value());
+    ASSERT_FALSE(queue.TryPop().has_value());
+}
+
+TEST_CASE(PriorityBlockQueue_MoveOnly_Type) {
+    auto cmp = [](const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) {
+        return *a < *b;
+    };
+    PriorityBlockQueue<std::unique_ptr<int>, decltype(cmp)> queue(4, cmp);
+    queue.TryPush(std::make_unique<int>(1));
+    queue.TryPush(std::make_unique<int>(7));
+
+    std::unique_ptr<int> out;
+    ASSERT_TRUE(queue.Pop(out));
+    ASSERT_EQ(7, *out);
+}
+
+TEST_CASE(PriorityBlockQueue_Close) {
+    PriorityBlockQueue<int> queue(4);
+    queue.TryPush(1);
+
+    std::thread producer([&queue]() {
+        queue.Push(2);
+        queue.Push(3);
+        queue.Push(4);
+        ASSERT_THROW(queue.Push(5), std::runtime_error);  // 队列满时阻塞，关闭后抛出
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.Close();
+    producer.join();
+
+    ASSERT_FALSE(queue.TryPush(6));
+    int val;
+    int count = 0;
+    while (queue.Pop(val)) {
+        ++count;
+    }
+    ASSERT_EQ(4, count);
+}
+
+TEST_CASE(PriorityBlockQueue_MultiThread) {
+    PriorityBlockQueue<int> queue(16);
+    const int num_producers = 4;
+    const int items_per_producer = 2000;
+    std::atomic<long long> sum{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue]() {
+            for (int i = 1; i <= items_per_producer; ++i) {
+                queue.Push(i);
+            }
+        });
+    }
+    std::thread consumer([&queue, &sum]() {
+        int val;
+        while (queue.Pop(val)) {
+            sum += val;
+        }
+    });
+
+    for (auto& t : producers) t.join();
+    queue.Close();
+    consumer.join();
+    ASSERT_EQ(static_cast<long long>(items_per_producer) * (items_per_producer + 1) / 2 * num_producers, sum.load());
+}
+
+// ==================== LeveledBlockQueue ====================
+
+TEST_CASE(LeveledBlockQueue_Order) {
+    LeveledBlockQueue<std::string, 3> queue(4);
+    ASSERT_EQ(3, queue.LevelCount());
+
+    queue.TryPush("bulk1", 2);
+    queue.TryPush("normal1", 1);
+    queue.TryPush("bulk2", 2);
+    queue.TryPush("urgent1", 0);
+    queue.TryPush("urgent2", 0);
+    ASSERT_EQ(5, queue.Size());
+    ASSERT_EQ(2, queue.Size(2));
+
+    std::vector<std::string> results;
+    std::vector<size_t> levels;
+    std::string item;
+    size_t level;
+    while (queue.Pop(item, 0, &level)) {
+        results.push_back(item);
+        levels.push_back(level);
+    }
+    std::vector<std::string> expected = {"urgent1", "urgent2", "normal1", "bulk1", "bulk2"};
+    std::vector<size_t> expected_levels = {0, 0, 1, 2, 2};
+    ASSERT_TRUE(results == expected);
+    ASSERT_TRUE(levels == expected_levels);
+}
+
+TEST_CASE(LeveledBlockQueue_Per_Level_Capacity) {
+    LeveledBlockQueue<int, 2> queue(2);
+
+    // 低优先级积压满，不影响高优先级入队
+    ASSERT_TRUE(queue.TryPush(1, 1));
+    ASSERT_TRUE(queue.TryPush(2, 1));
+    ASSERT_FALSE(queue.TryPush(3, 1));
+    ASSERT_TRUE(queue.TryPush(100, 0));
+    ASSERT_EQ(100, queue.TryPop().value());
+
+    ASSERT_THROW(queue.TryPush(1, 2), std::out_of_range);
+
+    // 超出时钟表示范围的时长饱和为无限等待
+    std::thread consumer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.TryPop();
+    });
+    ASSERT_TRUE(queue.Push(4, 1, std::chrono::hours::max()));
+    consumer.join();
+    ASSERT_EQ(2, queue.Size(1));
+}
+
+TEST_CASE(LeveledBlockQueue_Blocking_Producer_Per_Level) {
+    LeveledBlockQueue<int, 2> queue(1);
+    queue.TryPush(1, 1);
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&queue, &pushed]() {
+        queue.Push(2, 1);  // 级别 1 已满，等待该级别腾出空位
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(pushed);
+    int val;
+    ASSERT_TRUE(queue.Pop(val));
+    ASSERT_EQ(1, val);
+    producer.join();
+    ASSERT_TRUE(pushed);
+    ASSERT_EQ(2, queue.TryPop().value());
+}
+
+TEST_CASE(LeveledBlockQueue_Close) {
+    LeveledBlockQueue<int, 2> queue(4);
+    queue.TryPush(1, 1);
+
+    std::atomic<int> popped{0};
+    std::thread consumer([&queue, &popped]() {
+        int val;
+        while (queue.Pop(val)) {
+            popped++;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.Close();
+    consumer.join();
+
+    ASSERT_EQ(1, popped.load());
+    ASSERT_TRUE(queue.IsClosed());
+    ASSERT_THROW(queue.Push(1, 0), std::runtime_error);
+}
+
+void test_priority_block_queue() { RUN_ALL_TESTS(); }
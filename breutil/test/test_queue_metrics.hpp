@@ -0,0 +1,150 @@
+#pragma once
+
+// 队列统计的测试需在开启 BRE_QUEUE_METRICS 的构建中运行，未开启时只验证空实现
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../block_queue.hpp"
+#include "../easy_test.hpp"
+#include "../queue_metrics.hpp"
+
+using namespace bre;
+
+// ==================== LatencyHistogram ====================
+
+TEST_CASE(LatencyHistogram_Buckets_And_Percentile) {
+    LatencyHistogram histogram;
+    ASSERT_EQ(0, histogram.Count());
+    ASSERT_EQ(0, histogram.Percentile(0.5).count());
+
+    histogram.Record(std::chrono::nanoseconds(0));
+    histogram.Record(std::chrono::nanoseconds(1));
+    histogram.Record(std::chrono::nanoseconds(100));   // [64, 128)
+    histogram.Record(std::chrono::nanoseconds(1000));  // [512, 1024)
+    ASSERT_EQ(4, histogram.Count());
+    ASSERT_EQ(2, histogram.Bucket(0));
+    ASSERT_EQ(1, histogram.Bucket(6));
+    ASSERT_EQ(1, histogram.Bucket(9));
+    ASSERT_EQ(1101, histogram.Total().count());
+    ASSERT_EQ(1000, histogram.Max().count());
+
+    ASSERT_EQ(1, histogram.Percentile(0.5).count());
+    ASSERT_EQ(127, histogram.Percentile(0.75).count());
+    ASSERT_EQ(1000, histogram.Percentile(1.0).count());  // 不超过最大值
+
+    histogram.Record(std::chrono::hours(1));  // 超出范围的计入最后一个桶
+    ASSERT_EQ(1, histogram.Bucket(LatencyHistogram::kBuckets - 1));
+}
+
+// ==================== BlockQueue 统计 ====================
+
+#if BRE_QUEUE_METRICS
+
+TEST_CASE(BlockQueue_Metrics_Counters) {
+    BlockQueue<int> queue(3);
+    const auto start = queue.GetMetrics();
+    ASSERT_TRUE(start.enabled);
+
+    ASSERT_TRUE(queue.TryPush(1));
+    ASSERT_TRUE(queue.TryPush(2));
+    ASSERT_TRUE(queue.TryPush(3));
+    ASSERT_FALSE(queue.TryPush(4));
+    ASSERT_FALSE(queue.TryPush(5));
+
+    int value = 0;
+    ASSERT_TRUE(queue.Pop(value));
+    ASSERT_TRUE(queue.TryPop().has_value());
+    queue.Push(6);
+    queue.Clear();
+
+    const auto snapshot = queue.GetMetrics();
+    ASSERT_EQ(4, snapshot.pushed);
+    ASSERT_EQ(2, snapshot.popped);
+    ASSERT_EQ(2, snapshot.tryPushRejected);
+    ASSERT_EQ(3, snapshot.highWaterMark);
+    ASSERT_EQ(2, snapshot.residence.Count());  // Clear 掉的元素不计入停留时长
+    ASSERT_EQ(0, snapshot.pushBlocked.Count());
+    ASSERT_EQ(0, snapshot.popBlocked.Count());
+    ASSERT_GE(snapshot.PushRate(start), 0.0);
+
+    // 关闭导致的失败不算拒绝
+    queue.Close();
+    ASSERT_FALSE(queue.TryPush(7));
+    ASSERT_EQ(2, queue.GetMetrics().tryPushRejected);
+}
+
+TEST_CASE(BlockQueue_Metrics_Blocked_And_Residence) {
+    BlockQueue<int> queue(1);
+
+    // 消费者挂起等待约 20ms
+    std::thread consumer([&queue]() {
+        int value = 0;
+        queue.Pop(value);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.Push(1);
+    consumer.join();
+
+    // 元素在队列中停留约 20ms，期间生产者挂起等待空位
+    queue.Push(2);
+    std::thread producer([&queue]() { queue.Push(3); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(2, queue.TryPop().value());
+    producer.join();
+
+    const auto snapshot = queue.GetMetrics();
+    ASSERT_EQ(1, snapshot.popBlocked.Count());
+    ASSERT_GE(snapshot.popBlocked.Max(), std::chrono::milliseconds(10));
+    ASSERT_EQ(1, snapshot.pushBlocked.Count());
+    ASSERT_GE(snapshot.pushBlocked.Max(), std::chrono::milliseconds(10));
+    ASSERT_GE(snapshot.residence.Max(), std::chrono::milliseconds(10));
+    ASSERT_EQ(1, snapshot.highWaterMark);
+}
+
+TEST_CASE(BlockQueue_Metrics_Batch_Pop_Blocked) {
+    BlockQueue<int> queue(8);
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::vector<int> items{1, 2, 3};
+        queue.Push(items.begin(), items.end());
+    });
+    std::vector<int> out;
+    ASSERT_EQ(3, queue.Pop(std::back_inserter(out), 3, 8, std::chrono::seconds(1)));
+    producer.join();
+
+    const auto snapshot = queue.GetMetrics();
+    ASSERT_EQ(1, snapshot.popBlocked.Count());
+    ASSERT_EQ(3, snapshot.residence.Count());
+}
+
+TEST_CASE(BlockQueue_Metrics_DrainAll) {
+    BlockQueue<int> queue(8);
+    for (int i = 0; i < 5; ++i) {
+        queue.Push(i);
+    }
+    std::vector<int> out;
+    ASSERT_EQ(5, queue.DrainAll(out));
+
+    // 整批交换出去的元素照常计入出队数和停留时长，之后的入队出队不受影响
+    queue.Push(5);
+    ASSERT_EQ(5, queue.TryPop().value());
+    const auto snapshot = queue.GetMetrics();
+    ASSERT_EQ(6, snapshot.popped);
+    ASSERT_EQ(6, snapshot.residence.Count());
+}
+
+#else
+
+TEST_CASE(BlockQueue_Metrics_Disabled) {
+    BlockQueue<int> queue(2);
+    queue.TryPush(1);
+    const auto snapshot = queue.GetMetrics();
+    ASSERT_FALSE(snapshot.enabled);
+    ASSERT_EQ(0, snapshot.pushed);
+    static_assert(std::is_empty_v<QueueMetricsRecorder>);
+}
+
+#endif  // BRE_QUEUE_METRICS
+
+void test_queue_metrics() { RUN_ALL_TESTS(); }
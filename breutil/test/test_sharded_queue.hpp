@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../easy_test.hpp"
+#include "../sharded_queue.hpp"
+
+using namespace bre;
+
+// ==================== 基础功能测试 ====================
+
+TEST_CASE(ShardedQueue_Constructor) {
+    ShardedQueue<int> queue1(100, 4);
+    ASSERT_EQ(100, queue1.Capacity());
+    ASSERT_EQ(4, queue1.LaneCount());
+    ASSERT_TRUE(queue1.Empty());
+
+    ShardedQueue<int> queue2;
+    ASSERT_GE(queue2.LaneCount(), 1);
+}
+
+TEST_CASE(ShardedQueue_TryPush_TryPop) {
+    ShardedQueue<int> queue(8, 4);
+
+    // 同一线程落在同一通道，保持 FIFO
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(queue.TryPush(i));
+    }
+    ASSERT_TRUE(queue.Full());
+    ASSERT_FALSE(queue.TryPush(8));
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_EQ(i, queue.TryPop().value());
+    }
+    ASSERT_FALSE(queue.TryPop().has_value());
+}
+
+TEST_CASE(ShardedQueue_Capacity_Shared_Across_Lanes) {
+    ShardedQueue<int> queue(10, 4);
+    std::atomic<int> pushed{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&queue, &pushed]() {
+            for (int i = 0; i < 10; ++i) {
+                if (queue.TryPush(i)) {
+                    pushed++;
+                }
+            }
+        });
+    }
+    for (auto& t : producers) t.join();
+
+    // 总容量是所有通道合计
+    ASSERT_EQ(10, pushed.load());
+    ASSERT_EQ(10, queue.Size());
+}
+
+TEST_CASE(ShardedQueue_MoveOnly_Type) {
+    ShardedQueue<std::unique_ptr<std::string>> queue(4, 2);
+    ASSERT_TRUE(queue.TryPush(std::make_unique<std::string>("Hello")));
+
+    std::unique_ptr<std::string> out;
+    ASSERT_TRUE(queue.Pop(out));
+    ASSERT_EQ(std::string("Hello"), *out);
+}
+
+// ==================== 阻塞与超时测试 ====================
+
+TEST_CASE(ShardedQueue_Timeouts) {
+    ShardedQueue<int> queue(1, 2);
+
+    int val;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.Pop(val, 50));
+    ASSERT_GE((std::chrono::steady_clock::now() - start).count(), std::chrono::milliseconds(45).count());
+
+    queue.TryPush(1);
+    start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.Push(2, std::chrono::milliseconds(50)));
+    ASSERT_GE((std::chrono::steady_clock::now() - start).count(), std::chrono::milliseconds(45).count());
+
+    // 超出时钟表示范围的时长饱和为无限等待，不会溢出成立即超时
+    std::thread consumer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.TryPop();
+    });
+    ASSERT_TRUE(queue.Push(3, std::chrono::hours::max()));
+    consumer.join();
+}
+
+// 拷贝时可能抛出异常的元素类型
+struct ShardedQueueThrowing {
+    explicit ShardedQueueThrowing(int v) : value(v) {}
+    ShardedQueueThrowing(const ShardedQueueThrowing& other) : value(other.value) {
+        if (value < 0) throw std::runtime_error("copy failed");
+    }
+    ShardedQueueThrowing& operator=(const ShardedQueueThrowing&) = default;
+
+    int value;
+};
+
+TEST_CASE(ShardedQueue_Throwing_Push_Returns_Capacity) {
+    ShardedQueue<ShardedQueueThrowing> queue(1, 1);
+    const ShardedQueueThrowing bad(-1);
+    const ShardedQueueThrowing good(1);
+
+    // 构造失败后占用的容量归还，队列没有变满
+    ASSERT_THROW(queue.TryPush(bad), std::runtime_error);
+    ASSERT_EQ(0, queue.Size());
+    ASSERT_THROW(queue.Push(bad), std::runtime_error);
+    ASSERT_TRUE(queue.TryPush(good));
+    ASSERT_EQ(1, queue.TryPop()->value);
+
+    // 关闭后阻塞的 Pop 能发现已取空，不会一直等待
+    ASSERT_THROW(queue.TryPush(bad), std::runtime_error);
+    queue.Close();
+    ShardedQueueThrowing item(0);
+    ASSERT_FALSE(queue.Pop(item));
+}
+
+TEST_CASE(ShardedQueue_Close) {
+    ShardedQueue<int> queue(4, 2);
+    queue.TryPush(1);
+    queue.Close();
+
+    ASSERT_TRUE(queue.IsClosed());
+    ASSERT_FALSE(queue.TryPush(2));
+    ASSERT_THROW(queue.Push(3), std::runtime_error);
+
+    int val = 0;
+    ASSERT_TRUE(queue.Pop(val));
+    ASSERT_EQ(1, val);
+    ASSERT_FALSE(queue.Pop(val));
+}
+
+TEST_CASE(ShardedQueue_Close_Wakes_Waiting_Threads) {
+    ShardedQueue<int> queue(4, 2);
+    std::atomic<bool> pop_returned{false};
+
+    std::thread consumer([&queue, &pop_returned]() {
+        int val;
+        ASSERT_FALSE(queue.Pop(val));
+        pop_returned = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    queue.Close();
+    consumer.join();
+    ASSERT_TRUE(pop_returned);
+}
+
+// ==================== 多线程测试 ====================
+
+TEST_CASE(ShardedQueue_Per_Producer_FIFO) {
+    ShardedQueue<std::pair<int, int>> queue(64, 4);
+    const int num_producers = 8;
+    const int items_per_producer = 5000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < items_per_producer; ++i) {
+                queue.Push({p, i});
+            }
+        });
+    }
+
+    // 两个消费者各自看到的同一生产者的序号必须递增
+    std::atomic<int> consumed{0};
+    std::atomic<bool> ordered{true};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 2; ++c) {
+        consumers.emplace_back([&queue, &consumed, &ordered]() {
+            std::vector<int> last(num_producers, -1);
+            std::pair<int, int> item;
+            while (queue.Pop(item)) {
+                if (item.second <= last[item.first]) {
+                    ordered = false;
+                }
+                last[item.first] = item.second;
+                consumed++;
+            }
+        });
+    }
+
+    for (auto& t : producers) t.join();
+    queue.Close();
+    for (auto& t : consumers) t.join();
+
+    ASSERT_TRUE(ordered.load());
+    ASSERT_EQ(num_producers * items_per_producer, consumed.load());
+}
+
+TEST_CASE(ShardedQueue_PopBatch_RoundRobin) {
+    ShardedQueue<int> queue(1000, 4);
+    const int num_producers = 4;
+    const int items_per_producer = 10000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue]() {
+            for (int i = 1; i <= items_per_producer; ++i) {
+                queue.Push(i);
+            }
+        });
+    }
+
+    long long sum = 0;
+    int count = 0;
+    std::thread consumer([&queue, &sum, &count]() {
+        std::vector<int> batch;
+        while (queue.Pop(std::back_inserter(batch), 64) > 0) {
+            for (int v : batch) {
+                sum += v;
+            }
+            count += static_cast<int>(batch.size());
+            batch.clear();
+        }
+    });
+
+    for (auto& t : producers) t.join();
+    queue.Close();
+    consumer.join();
+
+    ASSERT_EQ(num_producers * items_per_producer, count);
+    ASSERT_EQ(static_cast<long long>(items_per_producer) * (items_per_producer + 1) / 2 * num_producers, sum);
+}
+
+void test_sharded_queue() { RUN_ALL_TESTS(); }
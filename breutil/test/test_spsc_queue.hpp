@@ -0,0 +1,255 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../easy_test.hpp"
+#include "../spsc_queue.hpp"
+
+using namespace bre;
+
+// ==================== 基础功能测试 ====================
+
+TEST_CASE(SpscQueue_TryPush_TryPop) {
+    SpscQueue<int, 4> queue;
+    ASSERT_EQ(4, queue.Capacity());
+    ASSERT_TRUE(queue.Empty());
+
+    ASSERT_TRUE(queue.TryPush(1));
+    ASSERT_TRUE(queue.TryPush(2));
+    ASSERT_EQ(2, queue.Size());
+
+    ASSERT_EQ(1, queue.TryPop().value());
+    ASSERT_EQ(2, queue.TryPop().value());
+    ASSERT_FALSE(queue.TryPop().has_value());
+}
+
+TEST_CASE(SpscQueue_Full_And_Wraparound) {
+    SpscQueue<int, 4> queue;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(queue.TryPush(round * 4 + i));
+        }
+        ASSERT_TRUE(queue.Full());
+        ASSERT_FALSE(queue.TryPush(-1));
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_EQ(round * 4 + i, queue.TryPop().value());
+        }
+    }
+}
+
+TEST_CASE(SpscQueue_TryEmplace_MoveOnly) {
+    SpscQueue<std::unique_ptr<std::string>, 2> queue;
+    ASSERT_TRUE(queue.TryEmplace(new std::string("Hello")));
+
+    auto str = std::make_unique<std::string>("World");
+    ASSERT_TRUE(queue.TryPush(std::move(str)));
+    ASSERT_NULL(str.get());
+
+    std::unique_ptr<std::string> out;
+    ASSERT_TRUE(queue.Pop(out));
+    ASSERT_EQ(std::string("Hello"), *out);
+    ASSERT_EQ(std::string("World"), **queue.TryPop());
+}
+
+TEST_CASE(SpscQueue_PushBatch) {
+    SpscQueue<int, 8> queue;
+    std::vector<int> items = {1, 2, 3, 4, 5, 6};
+
+    ASSERT_EQ(6, queue.Push(items.begin(), items.end()));
+    // 只剩 2 个空位
+    ASSERT_EQ(2, queue.Push(items.begin(), items.end()));
+    ASSERT_TRUE(queue.Full());
+}
+
+// 从 int 构造时可能抛出异常、统计存活实例数的元素类型
+struct SpscQueueTracked {
+    static inline int live = 0;
+
+    SpscQueueTracked(int v) : value(v) {
+        if (v < 0) throw std::runtime_error("rejected");
+        ++live;
+    }
+    SpscQueueTracked(const SpscQueueTracked& other) : value(other.value) { ++live; }
+    SpscQueueTracked& operator=(const SpscQueueTracked&) = default;
+    ~SpscQueueTracked() { --live; }
+
+    int value;
+};
+
+TEST_CASE(SpscQueue_PushBatch_Throwing_Constructor) {
+    SpscQueueTracked::live = 0;
+    {
+        SpscQueue<SpscQueueTracked, 8> queue;
+        std::vector<int> items = {1, 2, -1, 4};
+
+        // 抛出异常之前构造好的元素照常入队
+        ASSERT_THROW(queue.Push(items.begin(), items.end()), std::runtime_error);
+        ASSERT_EQ(2, queue.Size());
+        ASSERT_EQ(1, queue.TryPop()->value);
+        ASSERT_EQ(2, queue.TryPop()->value);
+        ASSERT_EQ(0, SpscQueueTracked::live);
+
+        // 之后的写入不会覆盖未析构的元素
+        ASSERT_EQ(1, queue.Push(items.begin() + 3, items.end()));
+        ASSERT_EQ(1, SpscQueueTracked::live);
+    }
+    ASSERT_EQ(0, SpscQueueTracked::live);
+}
+
+TEST_CASE(SpscQueue_PopBatch) {
+    SpscQueue<int, 8> queue;
+    for (int i = 1; i <= 5; ++i) {
+        queue.TryPush(i);
+    }
+
+    std::vector<int> results;
+    ASSERT_EQ(3, queue.TryPop(std::back_inserter(results), 3));
+    ASSERT_EQ(2, queue.Pop(std::back_inserter(results), 10));
+    ASSERT_EQ(5, results.size());
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(i + 1, results[i]);
+    }
+    ASSERT_EQ(0, queue.TryPop(std::back_inserter(results), 10));
+}
+
+// ==================== 关闭功能测试 ====================
+
+TEST_CASE(SpscQueue_Close) {
+    SpscQueue<int, 4> queue;
+    queue.TryPush(1);
+    queue.Close();
+
+    ASSERT_TRUE(queue.IsClosed());
+    ASSERT_FALSE(queue.TryPush(2));
+    ASSERT_THROW(queue.Push(3), std::runtime_error);
+
+    int val = 0;
+    ASSERT_TRUE(queue.Pop(val));
+    ASSERT_EQ(1, val);
+    ASSERT_FALSE(queue.Pop(val));
+}
+
+TEST_CASE(SpscQueue_Close_Wakes_Consumer) {
+    SpscQueue<int, 4> queue;
+    std::atomic<bool> pop_returned{false};
+
+    std::thread consumer([&queue, &pop_returned]() {
+        int val;
+        ASSERT_FALSE(queue.Pop(val));
+        pop_returned = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(pop_returned);
+    queue.Close();
+    consumer.join();
+    ASSERT_TRUE(pop_returned);
+}
+
+TEST_CASE(SpscQueue_Close_Wakes_Producer) {
+    SpscQueue<int, 2> queue;
+    queue.TryPush(1);
+    queue.TryPush(2);
+    std::atomic<bool> threw{false};
+
+    std::thread producer([&queue, &threw]() {
+        try {
+            queue.Push(3);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    queue.Close();
+    producer.join();
+    ASSERT_TRUE(threw);
+}
+
+// ==================== 多线程测试 ====================
+
+template <bool Blocking>
+static void RunSpscTransfer() {
+    SpscQueue<int, 16, Blocking> queue;
+    const int count = 100000;
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < count; ++i) {
+            queue.Push(i);
+        }
+        queue.Close();
+    });
+
+    int expected = 0;
+    int val;
+    bool ordered = true;
+    while (queue.Pop(val)) {
+        ordered = ordered && val == expected;
+        ++expected;
+    }
+    producer.join();
+    ASSERT_TRUE(ordered);
+    ASSERT_EQ(count, expected);
+}
+
+TEST_CASE(SpscQueue_Producer_Consumer_Blocking) {
+    RunSpscTransfer<true>();
+}
+
+TEST_CASE(SpscQueue_Producer_Consumer_Spinning) {
+    RunSpscTransfer<false>();
+}
+
+TEST_CASE(SpscQueue_Batch_Producer_Consumer) {
+    SpscQueue<int, 64> queue;
+    const int count = 100000;
+
+    std::thread producer([&queue]() {
+        std::vector<int> batch;
+        for (int i = 0; i < count;) {
+            batch.clear();
+            for (int j = 0; j < 32 && i + j < count; ++j) {
+                batch.push_back(i + j);
+            }
+            auto it = batch.begin();
+            while (it != batch.end()) {
+                it += queue.Push(it, batch.end());
+            }
+            i += static_cast<int>(batch.size());
+        }
+        queue.Close();
+    });
+
+    std::vector<int> results;
+    results.reserve(count);
+    while (queue.Pop(std::back_inserter(results), 32) > 0) {
+    }
+    producer.join();
+    ASSERT_EQ(count, results.size());
+    bool ordered = true;
+    for (int i = 0; i < count; ++i) {
+        ordered = ordered && results[i] == i;
+    }
+    ASSERT_TRUE(ordered);
+}
+
+TEST_CASE(SpscQueue_Destructor_Releases_Items) {
+    auto tracker = std::make_shared<int>(0);
+    {
+        SpscQueue<std::shared_ptr<int>, 4> queue;
+        queue.TryPush(tracker);
+        queue.TryPush(tracker);
+        queue.TryPop();
+        queue.TryPush(tracker);
+        ASSERT_EQ(3, tracker.use_count());
+    }
+    ASSERT_EQ(1, tracker.use_count());
+}
+
+void test_spsc_queue() { RUN_ALL_TESTS(); }
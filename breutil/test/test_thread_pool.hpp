@@ -0,0 +1,207 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../easy_test.hpp"
+#include "../thread_pool.hpp"
+#include "../work_stealing_deque.hpp"
+
+using namespace bre;
+
+// ==================== WorkStealingDeque ====================
+
+TEST_CASE(WorkStealingDeque_Owner_LIFO_Thief_FIFO) {
+    WorkStealingDeque<int> deque(4);
+    for (int i = 0; i < 10; ++i) {
+        deque.Push(i);  // 超过初始容量，触发扩容
+    }
+    ASSERT_EQ(10, deque.Size());
+    ASSERT_GE(deque.Capacity(), 10);
+
+    ASSERT_EQ(9, deque.Pop().value());
+    ASSERT_EQ(0, deque.Steal().value());
+    ASSERT_EQ(8, deque.Pop().value());
+    ASSERT_EQ(1, deque.Steal().value());
+    ASSERT_EQ(6, deque.Size());
+
+    while (deque.Pop()) {
+    }
+    ASSERT_TRUE(deque.Empty());
+    ASSERT_FALSE(deque.Pop().has_value());
+    ASSERT_FALSE(deque.Steal().has_value());
+}
+
+TEST_CASE(WorkStealingDeque_Concurrent_Steal_Takes_Each_Once) {
+    const int total = 100000;
+    const int num_thieves = 4;
+    WorkStealingDeque<int> deque(16);
+    std::vector<std::atomic<int>> seen(total);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < num_thieves; ++t) {
+        thieves.emplace_back([&]() {
+            while (!done.load() || !deque.Empty()) {
+                if (auto v = deque.Steal()) {
+                    seen[*v].fetch_add(1);
+                }
+            }
+        });
+    }
+
+    // 拥有者交替压入与弹出，与窃取者争抢最后一个元素
+    for (int i = 0; i < total; ++i) {
+        deque.Push(i);
+        if (i % 3 == 0) {
+            if (auto v = deque.Pop()) {
+                seen[*v].fetch_add(1);
+            }
+        }
+    }
+    while (auto v = deque.Pop()) {
+        seen[*v].fetch_add(1);
+    }
+    done.store(true);
+    for (auto& t : thieves) t.join();
+
+    int wrong = 0;
+    for (int i = 0; i < total; ++i) {
+        wrong += seen[i].load() != 1;
+    }
+    ASSERT_EQ(0, wrong);
+}
+
+// ==================== ThreadPool ====================
+
+TEST_CASE(ThreadPool_Submit_Returns_Future) {
+    ThreadPool pool(4);
+    ASSERT_EQ(4, pool.ThreadCount());
+
+    auto sum = pool.Submit([](int a, int b) { return a + b; }, 2, 3);
+    auto text = pool.Submit([](std::string s) { return s + "!"; }, std::string("hi"));
+    auto nothing = pool.Submit([] {});
+    ASSERT_EQ(5, sum.get());
+    ASSERT_EQ(std::string("hi!"), text.get());
+    nothing.get();
+}
+
+TEST_CASE(ThreadPool_Submit_Propagates_Exception) {
+    ThreadPool pool(2);
+    auto future = pool.Submit([]() -> int { throw std::runtime_error("boom"); });
+    ASSERT_THROW(future.get(), std::runtime_error);
+}
+
+TEST_CASE(ThreadPool_Post) {
+    std::atomic<int> executed{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 100; ++i) {
+            pool.Post([&executed] { executed.fetch_add(1); });
+        }
+    }  // 析构时 Close，执行完所有任务
+    ASSERT_EQ(100, executed.load());
+}
+
+TEST_CASE(ThreadPool_Nested_Submit) {
+    ThreadPool pool(4);
+    std::atomic<int> leaves{0};
+
+    // 工作线程内提交的子任务进入本线程队列，由其他线程窃取
+    std::function<void(int)> fork = [&](int depth) {
+        if (depth == 0) {
+            leaves.fetch_add(1);
+            return;
+        }
+        pool.Submit(fork, depth - 1);
+        pool.Submit(fork, depth - 1);
+    };
+    pool.Submit(fork, 12);
+    pool.Close();
+    ASSERT_EQ(1 << 12, leaves.load());
+}
+
+TEST_CASE(ThreadPool_ParallelFor) {
+    ThreadPool pool(4);
+    std::vector<int> data(10000, 0);
+    pool.ParallelFor(0, static_cast<int>(data.size()), [&data](int i) { data[i] = i; });
+    std::vector<int> expected(data.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    ASSERT_TRUE(data == expected);
+
+    // 空区间和不足一块的区间
+    pool.ParallelFor(5, 5, [](int) { throw std::runtime_error("unreachable"); });
+    std::atomic<int> count{0};
+    pool.ParallelFor(size_t(0), size_t(3), [&count](size_t) { count.fetch_add(1); }, 100);
+    ASSERT_EQ(3, count.load());
+}
+
+TEST_CASE(ThreadPool_ParallelFor_Nested_And_Exception) {
+    ThreadPool pool(3);
+    std::atomic<long long> sum{0};
+    // 工作线程中嵌套 ParallelFor，等待期间执行其他任务，不会死锁
+    pool.ParallelFor(0, 8, [&](int) {
+        pool.ParallelFor(0, 100, [&](int j) { sum.fetch_add(j); }, 10);
+    }, 1);
+    ASSERT_EQ(8LL * 4950, sum.load());
+
+    ASSERT_THROW(pool.ParallelFor(0, 100, [](int i) {
+        if (i == 42) {
+            throw std::runtime_error("bad index");
+        }
+    }, 1), std::runtime_error);
+}
+
+TEST_CASE(ThreadPool_Close_Drains_Pending) {
+    std::atomic<int> executed{0};
+    ThreadPool pool(2, 64);
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 1000; ++i) {
+        futures.push_back(pool.Submit([&executed]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+            executed.fetch_add(1);
+        }));
+    }
+    pool.Close();
+    ASSERT_EQ(1000, executed.load());
+    ASSERT_EQ(0, pool.Pending());
+    ASSERT_TRUE(pool.IsClosed());
+
+    ASSERT_THROW(pool.Submit([] {}), std::runtime_error);
+    ASSERT_THROW(pool.ParallelFor(0, 10, [](int) {}), std::runtime_error);
+    pool.Close();  // 重复关闭无副作用
+}
+
+TEST_CASE(ThreadPool_Concurrent_Submit_And_Close) {
+    std::atomic<int> accepted{0};
+    std::atomic<int> executed{0};
+    ThreadPool pool(2);
+
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < 4; ++t) {
+        submitters.emplace_back([&]() {
+            for (int i = 0; i < 10000; ++i) {
+                try {
+                    pool.Submit([&executed] { executed.fetch_add(1); });
+                    accepted.fetch_add(1);
+                } catch (const std::runtime_error&) {
+                    return;
+                }
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    pool.Close();
+    for (auto& t : submitters) t.join();
+
+    // 被接受的任务都已执行
+    ASSERT_EQ(accepted.load(), executed.load());
+}
+
+void test_thread_pool() { RUN_ALL_TESTS(); }
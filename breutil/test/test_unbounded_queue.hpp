@@ -0,0 +1,285 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../easy_test.hpp"
+#include "../unbounded_queue.hpp"
+
+using namespace bre;
+
+// 统计存活实例数的元素类型，用来检查元素既不泄漏也不会被析构两次
+struct UnboundedQueueTracked {
+    static inline std::atomic<long long> live{0};
+    static inline bool failCopy = false;
+
+    explicit UnboundedQueueTracked(int v) : value(v) {
+        if (v < 0) throw std::runtime_error("rejected");
+        live.fetch_add(1, std::memory_order_relaxed);
+    }
+    UnboundedQueueTracked(const UnboundedQueueTracked& other) : value(other.value) {
+        if (failCopy) throw std::runtime_error("copy failed");
+        live.fetch_add(1, std::memory_order_relaxed);
+    }
+    UnboundedQueueTracked& operator=(const UnboundedQueueTracked& other) {
+        if (failCopy) throw std::runtime_error("assign failed");
+        value = other.value;
+        return *this;
+    }
+    ~UnboundedQueueTracked() { live.fetch_sub(1, std::memory_order_relaxed); }
+
+    int value;
+};
+
+// ==================== 基础功能测试 ====================
+
+TEST_CASE(UnboundedQueue_TryPush_TryPop) {
+    UnboundedQueue<int> queue;
+    ASSERT_TRUE(queue.Empty());
+    ASSERT_FALSE(queue.TryPop().has_value());
+
+    // 没有容量上限
+    bool pushed = true;
+    for (int i = 0; i < 10000; ++i) {
+        pushed = queue.TryPush(i) && pushed;
+    }
+    ASSERT_TRUE(pushed);
+    ASSERT_FALSE(queue.Empty());
+    bool ordered = true;
+    for (int i = 0; i < 10000; ++i) {
+        ordered = ordered && queue.TryPop().value() == i;
+    }
+    ASSERT_TRUE(ordered);
+    ASSERT_TRUE(queue.Empty());
+}
+
+TEST_CASE(UnboundedQueue_MoveOnly_Type) {
+    UnboundedQueue<std::unique_ptr<std::string>> queue;
+    queue.Push(std::make_unique<std::string>("a"));
+    ASSERT_TRUE(queue.TryEmplace(std::make_unique<std::string>("b")));
+
+    std::unique_ptr<std::string> item;
+    ASSERT_TRUE(queue.Pop(item));
+    ASSERT_EQ(std::string("a"), *item);
+    ASSERT_EQ(std::string("b"), *queue.TryPop().value());
+}
+
+TEST_CASE(UnboundedQueue_Pop_With_Timeout) {
+    UnboundedQueue<int> queue;
+    int val = 0;
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.Pop(val, 50));
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(45));
+
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.Push(7);
+    });
+    ASSERT_TRUE(queue.Pop(val, 1000));
+    ASSERT_EQ(7, val);
+    producer.join();
+}
+
+TEST_CASE(UnboundedQueue_Recycles_Nodes) {
+    UnboundedQueue<int> queue;
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            queue.Push(i);
+        }
+        while (queue.TryPop().has_value()) {
+        }
+    }
+    // 10000 次 Push 只分配了少量节点，其余都来自空闲链表
+    ASSERT_LE(queue.AllocatedNodes(), 400);
+}
+
+TEST_CASE(UnboundedQueue_Throwing_Constructor) {
+    UnboundedQueueTracked::live = 0;
+    {
+        UnboundedQueue<UnboundedQueueTracked> queue;
+        ASSERT_TRUE(queue.TryEmplace(1));
+        ASSERT_THROW(queue.TryEmplace(-1), std::runtime_error);
+        ASSERT_TRUE(queue.TryEmplace(2));
+
+        ASSERT_EQ(1, queue.TryPop()->value);
+        ASSERT_EQ(2, queue.TryPop()->value);
+        ASSERT_FALSE(queue.TryPop().has_value());
+        ASSERT_TRUE(queue.TryEmplace(3));
+    }
+    ASSERT_EQ(0, UnboundedQueueTracked::live.load());
+}
+
+// 元素摘下后交给调用方时抛出异常：元素丢弃，旧节点照常退役，不泄漏也不重复析构
+TEST_CASE(UnboundedQueue_Throwing_Move_Out) {
+    UnboundedQueueTracked::live = 0;
+    {
+        UnboundedQueue<UnboundedQueueTracked> queue;
+        for (int i = 1; i <= 4; ++i) {
+            ASSERT_TRUE(queue.TryEmplace(i));
+        }
+        UnboundedQueueTracked item(0);
+        UnboundedQueueTracked::failCopy = true;
+        ASSERT_THROW(queue.TryPop(), std::runtime_error);
+        ASSERT_THROW(queue.Pop(item), std::runtime_error);
+        UnboundedQueueTracked::failCopy = false;
+
+        ASSERT_EQ(3, queue.TryPop()->value);
+        ASSERT_TRUE(queue.Pop(item, 10));
+        ASSERT_EQ(4, item.value);
+        ASSERT_TRUE(queue.Empty());
+        ASSERT_EQ(1, UnboundedQueueTracked::live.load());  // 只剩 item
+    }
+    ASSERT_EQ(0, UnboundedQueueTracked::live.load());
+}
+
+TEST_CASE(UnboundedQueue_Destructor_Releases_Items) {
+    auto tracker = std::make_shared<int>(0);
+    {
+        UnboundedQueue<std::shared_ptr<int>> queue;
+        queue.TryPush(tracker);
+        queue.TryPush(tracker);
+        queue.TryPush(tracker);
+        queue.TryPop();
+        ASSERT_EQ(3, tracker.use_count());
+    }
+    ASSERT_EQ(1, tracker.use_count());
+}
+
+// ==================== 关闭功能测试 ====================
+
+TEST_CASE(UnboundedQueue_Close) {
+    UnboundedQueue<int> queue;
+    queue.Push(1);
+    queue.Close();
+
+    ASSERT_TRUE(queue.IsClosed());
+    ASSERT_FALSE(queue.TryPush(2));
+    ASSERT_THROW(queue.Push(3), std::runtime_error);
+
+    int val = 0;
+    ASSERT_TRUE(queue.Pop(val));
+    ASSERT_EQ(1, val);
+    ASSERT_FALSE(queue.Pop(val));
+}
+
+TEST_CASE(UnboundedQueue_Close_Wakes_Consumer) {
+    UnboundedQueue<int> queue;
+    std::atomic<bool> pop_returned{false};
+
+    std::thread consumer([&queue, &pop_returned]() {
+        int val;
+        ASSERT_FALSE(queue.Pop(val));
+        pop_returned = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_FALSE(pop_returned);
+    queue.Close();
+    consumer.join();
+    ASSERT_TRUE(pop_returned);
+}
+
+// ==================== 多线程压力测试 ====================
+
+// 16 个生产者与 16 个消费者：每个元素恰好被取出一次，同一生产者的元素在每个消费者处保持顺序，
+// 结束后没有存活的元素。节点在线程间反复复用，ABA 会表现为元素丢失、重复或乱序
+TEST_CASE(UnboundedQueue_Stress_32_Threads) {
+    const int num_producers = 16;
+    const int num_consumers = 16;
+    const int items_per_producer = 20000;
+    const int total = num_producers * items_per_producer;
+    UnboundedQueueTracked::live = 0;
+
+    std::vector<std::atomic<int>> seen(total);
+    std::atomic<bool> ordered{true};
+    size_t allocated = 0;
+    {
+        UnboundedQueue<UnboundedQueueTracked> queue;
+        std::vector<std::thread> producers;
+        for (int p = 0; p < num_producers; ++p) {
+            producers.emplace_back([&queue, p]() {
+                for (int i = 0; i < items_per_producer; ++i) {
+                    queue.TryEmplace(p * items_per_producer + i);
+                }
+            });
+        }
+
+        std::vector<std::thread> consumers;
+        for (int c = 0; c < num_consumers; ++c) {
+            consumers.emplace_back([&]() {
+                std::vector<int> last(num_producers, -1);
+                UnboundedQueueTracked item(0);
+                while (queue.Pop(item)) {
+                    const int producer = item.value / items_per_producer;
+                    if (item.value <= last[producer]) {
+                        ordered = false;
+                    }
+                    last[producer] = item.value;
+                    seen[item.value].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        for (auto& t : producers) t.join();
+        queue.Close();
+        for (auto& t : consumers) t.join();
+        ASSERT_TRUE(queue.Empty());
+        allocated = queue.AllocatedNodes();
+    }
+
+    int exactly_once = 0;
+    for (auto& count : seen) {
+        exactly_once += count.load() == 1;
+    }
+    ASSERT_EQ(total, exactly_once);
+    ASSERT_TRUE(ordered.load());
+    ASSERT_EQ(0, UnboundedQueueTracked::live.load());
+    ASSERT_LE(allocated, static_cast<size_t>(total) + 1);
+}
+
+// 32 个线程各自交替 Push/Pop，队列始终很短，节点复用最频繁
+TEST_CASE(UnboundedQueue_Stress_Interleaved_Reuse) {
+    const int num_threads = 32;
+    const int ops_per_thread = 20000;
+    const int total = num_threads * ops_per_thread;
+    UnboundedQueue<int> queue;
+    std::vector<std::atomic<int>> seen(total);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&queue, &seen, t]() {
+            for (int i = 0; i < ops_per_thread; ++i) {
+                queue.Push(t * ops_per_thread + i);
+                if (auto item = queue.TryPop()) {
+                    seen[*item].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    while (auto item = queue.TryPop()) {
+        seen[*item].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int exactly_once = 0;
+    for (auto& count : seen) {
+        exactly_once += count.load() == 1;
+    }
+    ASSERT_EQ(total, exactly_once);
+
+    // 线程数多于核数时，被抢占的线程若停在临界区内会让纪元暂时无法推进，节点回收随之滞后；
+    // 所有线程退出后，之前退役的节点都能被回收复用，不再分配新节点
+    const size_t allocated = queue.AllocatedNodes();
+    for (int i = 0; i < 10000; ++i) {
+        queue.Push(i);
+        queue.TryPop();
+    }
+    ASSERT_EQ(allocated, queue.AllocatedNodes());
+}
+
+void test_unbounded_queue() { RUN_ALL_TESTS(); }
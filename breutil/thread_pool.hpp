@@ -0,0 +1,348 @@
+#pragma once
+
+/** thread_pool.hpp
+ * 工作窃取线程池。
+ * 每个工作线程有一个 Chase-Lev 双端队列（WorkStealingDeque），任务内部提交的子任务压入本线程队列底部，
+ * 本线程按 LIFO 执行；空闲时依次尝试全局注入队列和其他线程的队列顶部（窃取，FIFO）。
+ * 外部线程提交的任务进入全局注入队列（MpmcQueue），队列满时 Submit 阻塞，起到背压作用。
+ * 没有任务时工作线程通过 Parker 先自旋再挂起，提交方只在有线程挂起时才加锁唤醒。
+ *
+ * Close 之后外部线程不能再提交任务；已提交的任务（以及它们在执行中派生的子任务）全部执行完毕后
+ * 工作线程才退出，Close 返回时线程已全部回收。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mpmc_queue.hpp"
+#include "spin_wait.hpp"
+#include "work_stealing_deque.hpp"
+
+namespace bre {
+
+class ThreadPool {
+public:
+    /**
+     * @param threadCount 工作线程数，0 表示取 CPU 核数
+     * @param injectCapacity 全局注入队列的容量
+     */
+    explicit ThreadPool(size_t threadCount = 0, size_t injectCapacity = 4096) : _inject(injectCapacity) {
+        if (threadCount == 0) {
+            threadCount = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+        }
+        _workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            _workers.push_back(std::make_unique<Worker>(static_cast<uint32_t>(i) + 1));
+        }
+        for (size_t i = 0; i < threadCount; ++i) {
+            _workers[i]->thread = std::thread([this, i] {
+                run(i);
+            });
+        }
+    }
+
+    ~ThreadPool() { Close(); }
+
+    // 禁止拷贝和移动
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t ThreadCount() const { return _workers.size(); }
+
+    // 已提交但尚未执行完的任务数，近似快照
+    size_t Pending() const { return _pending.load(std::memory_order_relaxed); }
+
+    bool IsClosed() const { return _isClose.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 提交任务，返回其结果的 future；任务抛出的异常由 future.get() 重新抛出
+     * 在本池的工作线程中调用时压入当前线程的队列，否则进入全局注入队列（满时阻塞）
+     * @throw std::runtime_error 外部线程在 Close 之后提交
+     */
+    template <typename F, typename... Args>
+    auto Submit(F &&f, Args &&...args) -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+        using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+        std::packaged_task<R()> task(
+            [fn = std::forward<F>(f), ... params = std::forward<Args>(args)]() mutable -> R {
+                return std::invoke(std::move(fn), std::move(params)...);
+            });
+        std::future<R> future = task.get_future();
+        std::unique_ptr<Task> wrapped = makeTask(std::move(task));
+        if (!tryPost(wrapped)) {
+            throw std::runtime_error("ThreadPool is closed");
+        }
+        return future;
+    }
+
+    /**
+     * @brief 提交不需要结果的任务，省去 future 共享状态的开销，适合细粒度的 fork/join
+     * 任务不应抛出异常，否则调用 std::terminate
+     * @throw std::runtime_error 外部线程在 Close 之后提交
+     */
+    template <typename F>
+    void Post(F &&f) {
+        std::unique_ptr<Task> task = makeTask(std::forward<F>(f));
+        if (!tryPost(task)) {
+            throw std::runtime_error("ThreadPool is closed");
+        }
+    }
+
+    /**
+     * @brief 并行执行 body(i)，i 取遍 [begin, end)，返回时所有调用均已完成
+     * 区间按 grain 切块，调用线程与工作线程一起领取；在工作线程中调用时，等待期间会执行其他任务，
+     * 因此可以嵌套使用。第一个异常在全部块执行完后重新抛出
+     * @param grain 每块的下标数，0 表示按线程数自动切分
+     * @throw std::runtime_error 外部线程在 Close 之后调用
+     */
+    template <typename Index, typename F>
+    void ParallelFor(Index begin, Index end, F &&body, size_t grain = 0) {
+        static_assert(std::is_integral_v<Index>, "ParallelFor requires an integral index");
+        if (!(begin < end)) {
+            return;
+        }
+        if (IsClosed() && localIndex() == kNoWorker) {
+            throw std::runtime_error("ThreadPool is closed");
+        }
+        const size_t count = static_cast<size_t>(end - begin);
+        if (grain == 0) {
+            grain = std::max<size_t>(count / (ThreadCount() * 4), 1);
+        }
+        const size_t chunks = (count + grain - 1) / grain;
+
+        // 辅助任务可能在 ParallelFor 返回后才开始执行，此时领不到块，只访问共享状态
+        auto state = std::make_shared<ForState>();
+        auto runChunks = [state, &body, begin, count, grain, chunks] {
+            for (;;) {
+                const size_t chunk = state->next.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunks) {
+                    return;
+                }
+                const size_t first = chunk * grain;
+                const size_t last = std::min(first + grain, count);
+                try {
+                    for (size_t i = first; i < last; ++i) {
+                        body(static_cast<Index>(begin + static_cast<Index>(i)));
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> locker(state->mtx);
+                    if (!state->error) {
+                        state->error = std::current_exception();
+                    }
+                }
+                if (state->done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                    state->done.notify_all();
+                }
+            }
+        };
+
+        const size_t helpers = std::min(chunks - 1, ThreadCount());
+        for (size_t i = 0; i < helpers; ++i) {
+            std::unique_ptr<Task> task = makeTask(runChunks);
+            if (!tryPost(task)) {
+                break;  // 并发关闭，剩余的块由调用线程完成
+            }
+        }
+        runChunks();
+
+        // 等待被其他线程领走的块
+        const size_t index = localIndex();
+        size_t done = state->done.load(std::memory_order_acquire);
+        while (done < chunks) {
+            if (index != kNoWorker) {
+                if (Task *task = findTask(index)) {
+                    execute(task);
+                } else {
+                    std::this_thread::yield();
+                }
+            } else {
+                state->done.wait(done, std::memory_order_acquire);
+            }
+            done = state->done.load(std::memory_order_acquire);
+        }
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    /**
+     * @brief 关闭线程池：拒绝外部的新任务，执行完所有已提交的任务后回收工作线程
+     * 可重复调用；不能在本池的工作线程中调用
+     */
+    void Close() {
+        if (localIndex() != kNoWorker) {
+            throw std::logic_error("ThreadPool::Close called from a worker thread");
+        }
+        std::lock_guard<std::mutex> locker(_closeMtx);
+        _isClose.store(true, std::memory_order_seq_cst);
+        // 等待已通过关闭检查的外部提交完成入队，之后的提交都会失败
+        while (_submitting.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+        _stopping.store(true, std::memory_order_seq_cst);
+        _idle.WakeAll();
+        for (auto &worker : _workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kNoWorker = static_cast<size_t>(-1);
+
+    struct Task {
+        virtual ~Task() = default;
+        virtual void Run() noexcept = 0;
+    };
+
+    template <typename F>
+    struct TaskImpl final : Task {
+        template <typename U>
+        explicit TaskImpl(U &&f) : fn(std::forward<U>(f)) {}
+
+        void Run() noexcept override { fn(); }
+
+        F fn;
+    };
+
+    struct alignas(kCacheLineSize) Worker {
+        explicit Worker(uint32_t seed) : rng(seed) {}
+
+        WorkStealingDeque<Task *> deque;
+        std::thread thread;
+        uint32_t rng;  // 选择窃取起点，只由本线程访问
+    };
+
+    struct ForState {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mtx;
+        std::exception_ptr error;
+    };
+
+    // 当前线程所属的线程池及编号，用于把子任务压入本线程队列
+    struct Current {
+        const ThreadPool *pool = nullptr;
+        size_t index = kNoWorker;
+    };
+
+    static Current &current() {
+        thread_local Current cur;
+        return cur;
+    }
+
+    template <typename F>
+    static std::unique_ptr<Task> makeTask(F &&f) {
+        return std::make_unique<TaskImpl<std::decay_t<F>>>(std::forward<F>(f));
+    }
+
+    size_t localIndex() const {
+        const Current &cur = current();
+        return cur.pool == this ? cur.index : kNoWorker;
+    }
+
+    // 成功时接管 task；外部线程在关闭后提交返回 false，task 保持不变
+    bool tryPost(std::unique_ptr<Task> &task) {
+        const size_t index = localIndex();
+        if (index != kNoWorker) {
+            _pending.fetch_add(1, std::memory_order_seq_cst);
+            _workers[index]->deque.Push(task.release());
+            _idle.WakeOne();
+            return true;
+        }
+
+        // 与 Close 构成 Dekker 式握手：要么这里看到关闭标志，要么 Close 等到本次提交入队
+        _submitting.fetch_add(1, std::memory_order_seq_cst);
+        if (_isClose.load(std::memory_order_seq_cst)) {
+            _submitting.fetch_sub(1, std::memory_order_seq_cst);
+            return false;
+        }
+        _pending.fetch_add(1, std::memory_order_seq_cst);
+        _inject.Push(task.release());
+        _submitting.fetch_sub(1, std::memory_order_seq_cst);
+        _idle.WakeOne();
+        return true;
+    }
+
+    // 本线程队列 -> 全局注入队列 -> 从随机起点窃取其他线程的队列
+    Task *findTask(size_t index) {
+        Worker &self = *_workers[index];
+        if (auto task = self.deque.Pop()) {
+            return *task;
+        }
+        if (auto task = _inject.TryPop()) {
+            return *task;
+        }
+        const size_t n = _workers.size();
+        if (n > 1) {
+            self.rng ^= self.rng << 13;
+            self.rng ^= self.rng >> 17;
+            self.rng ^= self.rng << 5;
+            const size_t start = self.rng % n;
+            for (size_t i = 0; i < n; ++i) {
+                const size_t victim = (start + i) % n;
+                if (victim == index) {
+                    continue;
+                }
+                if (auto task = _workers[victim]->deque.Steal()) {
+                    return *task;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    void execute(Task *task) {
+        std::unique_ptr<Task> owned(task);
+        owned->Run();
+        owned.reset();
+        // 关闭过程中最后一个任务完成时叫醒挂起的线程退出
+        if (_pending.fetch_sub(1, std::memory_order_seq_cst) == 1 && _stopping.load(std::memory_order_seq_cst)) {
+            _idle.WakeAll();
+        }
+    }
+
+    void run(size_t index) {
+        current() = Current{this, index};
+        for (;;) {
+            Task *task = nullptr;
+            const bool ok = _idle.Park(
+                std::nullopt,
+                [&] {
+                    task = findTask(index);
+                    return task != nullptr;
+                },
+                [this] {
+                    return _stopping.load(std::memory_order_seq_cst) && _pending.load(std::memory_order_seq_cst) == 0;
+                });
+            if (!ok) {
+                break;
+            }
+            execute(task);
+        }
+        current() = Current{};
+    }
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    MpmcQueue<Task *> _inject;
+    alignas(kCacheLineSize) std::atomic<size_t> _pending{0};  // 已提交未完成，包括正在执行的任务
+    alignas(kCacheLineSize) std::atomic<size_t> _submitting{0};
+    std::atomic<bool> _isClose{false};
+    std::atomic<bool> _stopping{false};
+    Parker _idle;
+    std::mutex _closeMtx;
+};
+
+}  // namespace bre
@@ -0,0 +1,308 @@
+#pragma once
+
+/** unbounded_queue.hpp
+ * 无界多生产者多消费者无锁队列（Michael-Scott 链表队列）。
+ * 入队与出队分别只竞争尾指针与头指针，Push 永远不会因为容量而失败或阻塞；
+ * 只有消费者在队列空时需要挂起等待。
+ *
+ * 出队后摘下的哑节点交给 EpochDomain 按纪元退役，宽限期过后进入空闲链表供之后的 Push 复用，
+ * 稳态下不再调用分配器。节点只有在没有线程可能持有它时才会被复用，
+ * 因此头尾指针和空闲链表上的 CAS 都不会遇到 ABA 问题。
+ * 空闲链表只增不减，占用的内存等于队列曾经的最大长度，析构时全部释放。
+ * Close()/IsClosed() 的语义与 MpmcQueue 一致。
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "epoch_reclaim.hpp"
+#include "spin_wait.hpp"
+
+namespace bre {
+
+template <class T>
+class UnboundedQueue {
+public:
+    UnboundedQueue() {
+        Node *dummy = new Node;
+        _allocated.store(1, std::memory_order_relaxed);
+        _head.store(dummy, std::memory_order_relaxed);
+        _tail.store(dummy, std::memory_order_relaxed);
+    }
+
+    // 析构时不能有其他线程仍在使用队列
+    ~UnboundedQueue() {
+        Node *node = _head.load(std::memory_order_relaxed);
+        Node *next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        for (node = next; node != nullptr; node = next) {
+            next = node->next.load(std::memory_order_relaxed);
+            value(node)->~T();
+            delete node;
+        }
+        for (auto &retired : _retired) {
+            deleteChain(retired.load(std::memory_order_relaxed));
+        }
+        deleteChain(_freeList.load(std::memory_order_relaxed));
+    }
+
+    // 禁止拷贝和移动
+    UnboundedQueue(const UnboundedQueue &) = delete;
+    UnboundedQueue &operator=(const UnboundedQueue &) = delete;
+
+    /**
+     * 关闭队列：之后的 Push 失败，Pop 取完剩余元素后返回 false。
+     * 与 Close 并发进行的 Push 仍可能成功入队
+     */
+    void Close() {
+        _isClose.store(true, std::memory_order_seq_cst);
+        _consumers.WakeAll();
+    }
+
+    bool IsClosed() const { return _isClose.load(std::memory_order_acquire); }
+
+    // 近似快照
+    bool Empty() const {
+        auto guard = _domain.Pin();
+        return _head.load(std::memory_order_acquire)->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    // 分配过的节点总数（含哑节点、待回收与空闲链表中的节点），用于观察复用情况
+    size_t AllocatedNodes() const { return _allocated.load(std::memory_order_relaxed); }
+
+    // 非阻塞 Push，仅在队列已关闭时返回 false
+    bool TryPush(const T &item) { return emplace(item); }
+
+    bool TryPush(T &&item) { return emplace(std::move(item)); }
+
+    template <typename... Args>
+    bool TryEmplace(Args &&...args) {
+        return emplace(std::forward<Args>(args)...);
+    }
+
+    // 队列关闭时抛出异常
+    void Push(const T &item) {
+        if (!emplace(item)) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    void Push(T &&item) {
+        if (!emplace(std::move(item))) {
+            throw std::runtime_error("Queue is closed");
+        }
+    }
+
+    // 非阻塞
+    std::optional<T> TryPop() {
+        std::optional<T> item;
+        tryPop([&item](T &&value) {
+            item.emplace(std::move(value));
+        });
+        return item;
+    }
+
+    // 从队列拿走一个元素，队列关闭且为空时返回 false
+    bool Pop(T &item) { return waitPop(item, std::nullopt); }
+
+    bool Pop(T &item, int timeout_ms) {
+        return waitPop(item, DeadlineAfter(std::chrono::milliseconds(timeout_ms)));
+    }
+
+private:
+    using Deadline = Parker::Deadline;
+
+    // 每退役这么多个节点尝试推进一次纪元
+    static constexpr uint32_t kAdvanceInterval = 64;
+
+    struct Node {
+        std::atomic<Node *> next{nullptr};
+        std::atomic<Node *> link{nullptr};  // 退役链表与空闲链表的链接，与 next 分开：退役后仍可能有线程读 next
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static T *value(Node *node) { return std::launder(reinterpret_cast<T *>(node->storage)); }
+
+    static void deleteChain(Node *node) {
+        while (node != nullptr) {
+            Node *link = node->link.load(std::memory_order_relaxed);
+            delete node;
+            node = link;
+        }
+    }
+
+    template <typename... Args>
+    bool emplace(Args &&...args) {
+        if (_isClose.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        {
+            auto guard = _domain.Pin();
+            Node *node = allocate();
+            try {
+                new (node->storage) T(std::forward<Args>(args)...);
+            } catch (...) {
+                retire(node);  // 不能直接放回空闲链表：别的线程可能正读着它，直接压回会引入 ABA
+                throw;
+            }
+            node->next.store(nullptr, std::memory_order_relaxed);
+            link(node);
+        }
+        _consumers.WakeOne();
+        return true;
+    }
+
+    void link(Node *node) {
+        for (;;) {
+            Node *tail = _tail.load(std::memory_order_acquire);
+            Node *next = tail->next.load(std::memory_order_acquire);
+            if (tail != _tail.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (next == nullptr) {
+                if (tail->next.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed)) {
+                    _tail.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+                    return;
+                }
+            } else {
+                // 尾指针落后，帮忙推进
+                _tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * 抢到头指针的线程拥有新头节点里的元素，把它以右值交给 sink 后析构；
+     * 新头节点成为哑节点，旧的哑节点退役。
+     * 此时元素已经摘下，sink 抛出异常（T 的移动构造/赋值抛出）时元素丢弃，照样析构并退役旧节点
+     */
+    template <typename Sink>
+    bool tryPop(Sink &&sink) {
+        auto guard = _domain.Pin();
+        for (;;) {
+            Node *head = _head.load(std::memory_order_acquire);
+            Node *tail = _tail.load(std::memory_order_acquire);
+            Node *next = head->next.load(std::memory_order_acquire);
+            if (head != _head.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (next == nullptr) {
+                return false;  // 空
+            }
+            if (head == tail) {
+                _tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if (_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                T *item = value(next);
+                try {
+                    sink(std::move(*item));
+                } catch (...) {
+                    item->~T();
+                    retire(head);
+                    throw;
+                }
+                item->~T();
+                retire(head);
+                return true;
+            }
+        }
+    }
+
+    // 需持有 Guard：按当前纪元挂到对应的退役链表上
+    void retire(Node *node) {
+        std::atomic<Node *> &list = _retired[_domain.Current() % 3];
+        Node *top = list.load(std::memory_order_relaxed);
+        do {
+            node->link.store(top, std::memory_order_relaxed);
+        } while (!list.compare_exchange_weak(top, node, std::memory_order_release, std::memory_order_relaxed));
+
+        thread_local uint32_t retiredSinceAdvance = 0;
+        if (++retiredSinceAdvance >= kAdvanceInterval) {
+            retiredSinceAdvance = 0;
+            reclaim();
+        }
+    }
+
+    // 需持有 Guard：推进纪元成功后，把两个纪元之前退役的节点移入空闲链表
+    bool reclaim() {
+        uint64_t epoch;
+        if (!_domain.TryAdvance(epoch)) {
+            return false;
+        }
+        Node *first = _retired[(epoch + 1) % 3].exchange(nullptr, std::memory_order_acquire);
+        if (first == nullptr) {
+            return false;
+        }
+        Node *last = first;
+        while (Node *link = last->link.load(std::memory_order_relaxed)) {
+            last = link;
+        }
+        pushFree(first, last);
+        return true;
+    }
+
+    void pushFree(Node *first, Node *last) {
+        Node *top = _freeList.load(std::memory_order_relaxed);
+        do {
+            last->link.store(top, std::memory_order_relaxed);
+        } while (!_freeList.compare_exchange_weak(top, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // 需持有 Guard：节点回到空闲链表前要经过宽限期，持有 Guard 时读到的栈顶不会被别人弹出后又压回
+    Node *popFree() {
+        Node *top = _freeList.load(std::memory_order_acquire);
+        while (top != nullptr && !_freeList.compare_exchange_weak(top, top->link.load(std::memory_order_relaxed),
+                                                                  std::memory_order_acquire,
+                                                                  std::memory_order_acquire)) {
+        }
+        return top;
+    }
+
+    Node *allocate() {
+        Node *node = popFree();
+        // 只有下一次推进能回收到节点时才尝试，队列持续增长时不必每次都扫描纪元计数
+        if (node == nullptr && _retired[(_domain.Current() + 2) % 3].load(std::memory_order_relaxed) != nullptr &&
+            reclaim()) {
+            node = popFree();
+        }
+        if (node == nullptr) {
+            node = new Node;
+            _allocated.fetch_add(1, std::memory_order_relaxed);
+        }
+        return node;
+    }
+
+    // 关闭后 Pop 仍要先取完剩余元素，所以只有 op 失败时才看关闭标志（见 Parker::Park）
+    bool closed() const { return _isClose.load(std::memory_order_relaxed); }
+
+    bool waitPop(T &item, Deadline deadline) {
+        return _consumers.Park(
+            deadline,
+            [&] {
+                return tryPop([&item](T &&value) {
+                    item = std::move(value);
+                });
+            },
+            [this] {
+                return closed();
+            });
+    }
+
+    alignas(kCacheLineSize) std::atomic<Node *> _head{nullptr};
+    alignas(kCacheLineSize) std::atomic<Node *> _tail{nullptr};
+    alignas(kCacheLineSize) std::atomic<Node *> _freeList{nullptr};
+    std::atomic<Node *> _retired[3] = {};
+    std::atomic<size_t> _allocated{0};
+    alignas(kCacheLineSize) std::atomic<bool> _isClose{false};
+    mutable EpochDomain _domain;
+    Parker _consumers;
+};
+
+}  // namespace bre
@@ -0,0 +1,141 @@
+#pragma once
+
+/** work_stealing_deque.hpp
+ * Chase-Lev 工作窃取双端队列（按 Lê 等人给出的 C11 内存序版本实现）。
+ * 拥有者线程在底部 Push/Pop（LIFO，缓存友好），其他线程从顶部 Steal（FIFO）。
+ * 元素须可平凡拷贝（通常是指针），槽位以原子变量存放，允许窃取者与拥有者并发读写。
+ * 数组写满时由拥有者扩容为两倍；旧数组可能仍被窃取者读取，保留到析构时统一释放。
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "spin_wait.hpp"
+
+namespace bre {
+
+template <class T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable element type");
+
+public:
+    /**
+     * @param capacity 初始容量，向上取整到 2 的幂
+     */
+    explicit WorkStealingDeque(size_t capacity = 256) {
+        size_t n = 2;
+        while (n < capacity) {
+            n <<= 1;
+        }
+        _retired.push_back(std::make_unique<Array>(n));
+        _array.store(_retired.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    // 近似快照
+    size_t Size() const {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool Empty() const { return Size() == 0; }
+
+    size_t Capacity() const { return _array.load(std::memory_order_relaxed)->capacity; }
+
+    /**
+     * @brief 压入底部，仅拥有者线程调用
+     */
+    void Push(T item) {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_acquire);
+        Array *array = _array.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(array->capacity) - 1) {
+            array = grow(array, t, b);
+        }
+        array->Put(b, item);
+        // 原算法为 release fence + relaxed store；直接用 release store 语义相同，也能被 TSan 识别
+        _bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 从底部弹出，仅拥有者线程调用；只剩一个元素时与窃取者竞争
+     */
+    std::optional<T> Pop() {
+        const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        Array *array = _array.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+        if (t > b) {
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        T item = array->Get(b);
+        if (t == b) {
+            const bool won =
+                _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) {
+                return std::nullopt;
+            }
+        }
+        return item;
+    }
+
+    /**
+     * @brief 从顶部窃取，任意线程可调用；与其他线程竞争失败时返回空
+     */
+    std::optional<T> Steal() {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = _bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return std::nullopt;
+        }
+        Array *array = _array.load(std::memory_order_acquire);
+        T item = array->Get(t);
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return item;
+    }
+
+private:
+    struct Array {
+        explicit Array(size_t n) : capacity(n), mask(n - 1), slots(new std::atomic<T>[n]) {}
+
+        T Get(int64_t i) const { return slots[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed); }
+
+        void Put(int64_t i, T item) { slots[static_cast<size_t>(i) & mask].store(item, std::memory_order_relaxed); }
+
+        const size_t capacity;
+        const size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    Array *grow(Array *old, int64_t t, int64_t b) {
+        auto array = std::make_unique<Array>(old->capacity * 2);
+        for (int64_t i = t; i < b; ++i) {
+            array->Put(i, old->Get(i));
+        }
+        Array *raw = array.get();
+        _retired.push_back(std::move(array));
+        _array.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(kCacheLineSize) std::atomic<int64_t> _top{0};
+    alignas(kCacheLineSize) std::atomic<int64_t> _bottom{0};
+    std::atomic<Array *> _array;
+    std::vector<std::unique_ptr<Array>> _retired;  // 拥有者独占，包含当前数组
+};
+
+}  // namespace bre
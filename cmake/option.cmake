@@ -1,5 +1,6 @@
 option(BUILD_TESTS "Build the unit tests" On)
 option(BUILD_TOOLS "Build the unit tools" OFF)
+option(BRE_QUEUE_METRICS "Enable BlockQueue runtime metrics" OFF)
 
 if(LINUX)
     option(BUILD_BENCHMARK "Build the unit benchmark" ON)
@@ -11,6 +12,12 @@ endif()
 message(STATUS "BUILD_TESTS: ${BUILD_TESTS}")
 message(STATUS "BUILD_TOOLS: ${BUILD_TOOLS}")
 message(STATUS "BUILD_BENCHMARK: ${BUILD_BENCHMARK}")
+message(STATUS "BRE_QUEUE_METRICS: ${BRE_QUEUE_METRICS}")
+
+# 队列统计会改变 BlockQueue 的布局，需对所有目标统一定义
+if(BRE_QUEUE_METRICS)
+    add_definitions(-DBRE_QUEUE_METRICS=1)
+endif()
 
 # 添加子目录
 if(BUILD_TOOLS)
@@ -353,4 +353,233 @@ BOOST_AUTO_TEST_CASE(test_continuous_prepend_append) {
     BOOST_CHECK_EQUAL(buffer.RetrieveAllAsString(), "StartMiddleEnd");
 }
 
+BOOST_AUTO_TEST_CASE(test_find_delim) {
+    bre::Buffer buffer;
+    buffer.Append("key: value|next||end");
+
+    const char* colon = buffer.FindDelim(':');
+    BOOST_REQUIRE(colon != nullptr);
+    BOOST_CHECK_EQUAL(std::string(buffer.Peek(), colon - buffer.Peek()), "key");
+
+    const char* pipes = buffer.FindDelim('|', '|');
+    BOOST_REQUIRE(pipes != nullptr);
+    BOOST_CHECK_EQUAL(std::string(buffer.Peek(), pipes - buffer.Peek()), "key: value|next");
+
+    BOOST_CHECK(buffer.FindDelim('#') == nullptr);
+    BOOST_CHECK(buffer.FindDelim('d', '|') == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_find_crlf_simd_boundaries) {
+    // CRLF 落在 16/32 字节块内部、块边界上以及尾部标量区，结果都应与逐字节查找一致
+    for (size_t len = 2; len < 200; ++len) {
+        for (size_t pos = 0; pos + 1 < len; pos += 7) {
+            std::string data(len, 'x');
+            data[pos] = '\r';
+            data[pos + 1] = '\n';
+            if (pos > 0) {
+                data[pos - 1] = '\r';  // 孤立的 '\r' 不能被误判
+            }
+
+            bre::Buffer buffer;
+            buffer.Append(data);
+            const char* crlf = buffer.FindCRLF();
+            BOOST_REQUIRE(crlf != nullptr);
+            BOOST_CHECK_EQUAL(static_cast<size_t>(crlf - buffer.Peek()), pos);
+
+            const char* scalar = bre::simd::FindPairScalar(buffer.Peek(), buffer.BeginWrite(), '\r', '\n');
+            BOOST_CHECK(scalar == crlf);
+#ifdef BRE_SIMD_X86
+            BOOST_CHECK(bre::simd::FindPairSse2(buffer.Peek(), buffer.BeginWrite(), '\r', '\n') == crlf);
+#endif
+        }
+    }
+
+    // 最后一个字节是 '\r' 时不能越界匹配
+    bre::Buffer buffer;
+    buffer.Append(std::string(63, 'x') + "\r");
+    BOOST_CHECK(buffer.FindCRLF() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_crlf_incremental) {
+    bre::Buffer buffer;
+    buffer.Append("GET / HTTP/1.1");
+    BOOST_CHECK(buffer.ScanCRLF() == nullptr);
+
+    // '\r' 和 '\n' 分两次到达
+    buffer.Append("\r");
+    BOOST_CHECK(buffer.ScanCRLF() == nullptr);
+    buffer.Append("\nHost: a");
+
+    const char* crlf = buffer.ScanCRLF();
+    BOOST_REQUIRE(crlf != nullptr);
+    BOOST_CHECK_EQUAL(std::string(buffer.Peek(), crlf - buffer.Peek()), "GET / HTTP/1.1");
+    BOOST_CHECK(buffer.ScanCRLF() == crlf);  // 未取出前重复调用结果不变
+
+    buffer.RetrieveUntil(crlf + 2);
+    BOOST_CHECK(buffer.ScanCRLF() == nullptr);
+    buffer.Append("\r\n");
+    crlf = buffer.ScanCRLF();
+    BOOST_REQUIRE(crlf != nullptr);
+    BOOST_CHECK_EQUAL(std::string(buffer.Peek(), crlf - buffer.Peek()), "Host: a");
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_survives_growth_and_shrink) {
+    bre::Buffer buffer(16);
+    std::string header(100, 'h');
+    for (size_t i = 0; i < header.size(); i += 10) {
+        buffer.Append(header.substr(i, 10));  // 多次扩容 / 搬移
+        BOOST_CHECK(buffer.ScanCRLF() == nullptr);
+        BOOST_CHECK(buffer.ScanEOL() == nullptr);
+    }
+    buffer.Retrieve(30);
+    buffer.Shrink();
+    BOOST_CHECK(buffer.ScanCRLF() == nullptr);
+
+    buffer.Append("\r\n");
+    const char* crlf = buffer.ScanCRLF();
+    BOOST_REQUIRE(crlf != nullptr);
+    BOOST_CHECK_EQUAL(static_cast<size_t>(crlf - buffer.Peek()), 70u);
+    const char* eol = buffer.ScanEOL();
+    BOOST_REQUIRE(eol != nullptr);
+    BOOST_CHECK_EQUAL(static_cast<size_t>(eol - buffer.Peek()), 71u);
+}
+
+BOOST_AUTO_TEST_CASE(test_scan_reset_on_prepend_and_retrieve_all) {
+    bre::Buffer buffer;
+    buffer.Append("abc");
+    BOOST_CHECK(buffer.ScanEOL() == nullptr);
+    buffer.Prepend("\n", 1);
+    const char* eol = buffer.ScanEOL();
+    BOOST_REQUIRE(eol != nullptr);
+    BOOST_CHECK(eol == buffer.Peek());
+
+    buffer.RetrieveAll();
+    buffer.Append("x\n");
+    eol = buffer.ScanEOL();
+    BOOST_REQUIRE(eol != nullptr);
+    BOOST_CHECK_EQUAL(static_cast<size_t>(eol - buffer.Peek()), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_reuse_after_move) {
+    bre::Buffer buffer1;
+    buffer1.Append("Test data");
+    bre::Buffer buffer2(std::move(buffer1));
+
+    // 被移走的对象没有存储，但仍可以继续使用
+    BOOST_CHECK_EQUAL(buffer1.WritableBytes(), 0);
+    buffer1.RetrieveAll();
+    BOOST_CHECK_EQUAL(buffer1.WritableBytes(), 0);
+    buffer1.Append("again");
+    BOOST_CHECK_EQUAL(buffer1.RetrieveAllAsString(), "again");
+    BOOST_CHECK_EQUAL(buffer2.RetrieveAllAsString(), "Test data");
+}
+
+BOOST_AUTO_TEST_CASE(test_growth_keeps_only_readable_bytes) {
+    bre::Buffer buffer(16);
+    buffer.Append("0123456789abcdef");
+    buffer.Retrieve(10);
+
+    // 扩容后只保留可读数据，读索引回到预留区之后
+    buffer.Append(std::string(64, 'x'));
+    BOOST_CHECK_EQUAL(buffer.PrependableBytes(), bre::Buffer::kPrependSize);
+    BOOST_CHECK_EQUAL(buffer.RetrieveAllAsString(), "abcdef" + std::string(64, 'x'));
+}
+
+BOOST_AUTO_TEST_CASE(test_geometric_growth_amortized) {
+    bre::Buffer buffer(16);
+    const size_t total = 100000;
+    for (size_t i = 0; i < total; ++i) {
+        buffer.Append("x", 1);
+    }
+    BOOST_CHECK_EQUAL(buffer.ReadableBytes(), total);
+
+    // 每次翻倍：扩容次数为对数级，累计拷贝量不超过总数据量的两倍
+    const auto& stats = buffer.GetGrowthStats();
+    BOOST_CHECK(stats.reallocations <= 16);
+    BOOST_CHECK(stats.bytesCopied <= 2 * total);
+}
+
+BOOST_AUTO_TEST_CASE(test_exact_fit_growth_policy) {
+    bre::Buffer buffer(16);
+    bre::Buffer::GrowthPolicy policy;
+    policy.factor = 1.0;
+    buffer.SetGrowthPolicy(policy);
+
+    buffer.Append(std::string(16, 'a'));
+    buffer.Append("b", 1);
+    BOOST_CHECK_EQUAL(buffer.Capacity(), bre::Buffer::kPrependSize + 17);
+    buffer.Append("c", 1);
+    BOOST_CHECK_EQUAL(buffer.GetGrowthStats().reallocations, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(test_growth_max_step_and_hugepage) {
+    bre::Buffer buffer(1000);
+    bre::Buffer::GrowthPolicy policy;
+    policy.maxStep = 100;
+    buffer.SetGrowthPolicy(policy);
+    buffer.Append(std::string(1001, 'a'));
+    BOOST_CHECK_EQUAL(buffer.Capacity(), bre::Buffer::kPrependSize + 1000 + 100);
+
+    bre::Buffer big(bre::Buffer::kHugePageSize);
+    policy = bre::Buffer::GrowthPolicy{};
+    policy.hugePageAlign = true;
+    big.SetGrowthPolicy(policy);
+    big.Append(std::string(bre::Buffer::kHugePageSize + 1, 'b'));
+    BOOST_CHECK_EQUAL(big.Capacity() % bre::Buffer::kHugePageSize, 0u);
+    BOOST_CHECK(big.WritableBytes() > 0);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+BOOST_AUTO_TEST_CASE(test_read_fd_extrabuf) {
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+
+    // 数据量远大于可写空间，超出部分经由栈上额外缓冲区，一次 readv 全部读入
+    std::string data(60000, 'r');
+    data.back() = 'z';
+    BOOST_REQUIRE_EQUAL(::write(fds[1], data.data(), data.size()), static_cast<ssize_t>(data.size()));
+
+    bre::Buffer buffer(1024);
+    int savedErrno = 0;
+    const ssize_t n = buffer.ReadFd(fds[0], &savedErrno);
+    BOOST_CHECK_EQUAL(n, static_cast<ssize_t>(data.size()));
+    BOOST_CHECK_EQUAL(buffer.ReadableBytes(), data.size());
+    BOOST_CHECK(buffer.RetrieveAllAsString() == data);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_fd_retrieves_written) {
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+
+    bre::Buffer buffer;
+    buffer.Append("Hello, Pipe!");
+    int savedErrno = 0;
+    BOOST_CHECK_EQUAL(buffer.WriteFd(fds[1], &savedErrno), 12);
+    BOOST_CHECK_EQUAL(buffer.ReadableBytes(), 0);
+
+    bre::Buffer received;
+    BOOST_CHECK_EQUAL(received.ReadFd(fds[0], &savedErrno), 12);
+    BOOST_CHECK_EQUAL(received.ToString(), "Hello, Pipe!");
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+BOOST_AUTO_TEST_CASE(test_fd_errors_keep_errno) {
+    bre::Buffer buffer;
+    buffer.Append("data");
+    int savedErrno = 0;
+    BOOST_CHECK_EQUAL(buffer.ReadFd(-1, &savedErrno), -1);
+    BOOST_CHECK_EQUAL(savedErrno, EBADF);
+
+    savedErrno = 0;
+    BOOST_CHECK_EQUAL(buffer.WriteFd(-1, &savedErrno), -1);
+    BOOST_CHECK_EQUAL(savedErrno, EBADF);
+    BOOST_CHECK_EQUAL(buffer.ToString(), "data");  // 出错时不取出数据
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+#define BOOST_TEST_MODULE BufferChainTest
+#include <boost/test/included/unit_test.hpp>
+#include "breutil/buffer_chain.hpp"
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(BufferChainTestSuite)
+
+BOOST_AUTO_TEST_CASE(test_initial_state) {
+    bre::BufferChain chain;
+    BOOST_CHECK_EQUAL(chain.ReadableBytes(), 0);
+    BOOST_CHECK_EQUAL(chain.BlockCount(), 0);
+    BOOST_CHECK_EQUAL(chain.ToString(), "");
+}
+
+BOOST_AUTO_TEST_CASE(test_append_spans_blocks) {
+    auto pool = std::make_shared<bre::BlockPool>(16);
+    bre::BufferChain chain(pool);
+
+    std::string data;
+    for (int i = 0; i < 10; ++i) {
+        data += "0123456789";
+    }
+    chain.Append(data);
+    BOOST_CHECK_EQUAL(chain.ReadableBytes(), 100);
+    BOOST_CHECK_EQUAL(chain.BlockCount(), 7);  // 100 / 16 向上取整
+    BOOST_CHECK_EQUAL(chain.ToString(), data);
+}
+
+BOOST_AUTO_TEST_CASE(test_retrieve_releases_blocks) {
+    auto pool = std::make_shared<bre::BlockPool>(16);
+    bre::BufferChain chain(pool);
+    chain.Append(std::string(64, 'a'));
+    chain.Append("tail");
+
+    chain.Retrieve(40);
+    BOOST_CHECK_EQUAL(chain.ReadableBytes(), 28);
+    BOOST_CHECK_EQUAL(chain.BlockCount(), 3);
+    BOOST_CHECK_EQUAL(pool->CachedBlocks(), 2);
+
+    BOOST_CHECK_EQUAL(chain.RetrieveAsString(24), std::string(24, 'a'));
+    BOOST_CHECK_EQUAL(chain.RetrieveAllAsString(), "tail");
+    BOOST_CHECK_EQUAL(chain.ReadableBytes(), 0);
+
+    // 清空后保留一个块，再次追加不需要向池申请
+    BOOST_CHECK_EQUAL(chain.BlockCount(), 1);
+    const size_t cached = pool->CachedBlocks();
+    chain.Append("again");
+    BOOST_CHECK_EQUAL(pool->CachedBlocks(), cached);
+    BOOST_CHECK_EQUAL(chain.ToString(), "again");
+}
+
+BOOST_AUTO_TEST_CASE(test_pool_reuses_blocks) {
+    auto pool = std::make_shared<bre::BlockPool>(32, 2);
+    {
+        bre::BufferChain chain(pool);
+        chain.Append(std::string(32 * 4, 'x'));
+    }
+    // 最多缓存 2 个块，其余直接释放
+    BOOST_CHECK_EQUAL(pool->CachedBlocks(), 2);
+
+    bre::BufferChain chain(pool);
+    chain.Append(std::string(40, 'y'));
+    BOOST_CHECK_EQUAL(pool->CachedBlocks(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_splice_without_copy) {
+    auto pool = std::make_shared<bre::BlockPool>(16);
+    bre::BufferChain head(pool);
+    bre::BufferChain body(pool);
+    head.Append("HTTP/1.1 200 OK\r\n\r\n");
+    body.Append(std::string(50, 'b'));
+
+    const size_t blocks = head.BlockCount() + body.BlockCount();
+    head.Splice(body);
+    BOOST_CHECK_EQUAL(head.BlockCount(), blocks);
+    BOOST_CHECK_EQUAL(head.ReadableBytes(), 19 + 50);
+    BOOST_CHECK_EQUAL(body.ReadableBytes(), 0);
+    BOOST_CHECK_EQUAL(body.BlockCount(), 0);
+    BOOST_CHECK_EQUAL(head.ToString(), "HTTP/1.1 200 OK\r\n\r\n" + std::string(50, 'b'));
+
+    // 被拼接的链仍可继续使用
+    body.Append("next");
+    BOOST_CHECK_EQUAL(body.ToString(), "next");
+}
+
+BOOST_AUTO_TEST_CASE(test_splice_across_pools) {
+    auto small = std::make_shared<bre::BlockPool>(8);
+    auto large = std::make_shared<bre::BlockPool>(64);
+    bre::BufferChain a(small);
+    bre::BufferChain b(large);
+    a.Append("0123456789");
+    b.Append("abcdefghij");
+
+    a.Splice(b);
+    BOOST_CHECK_EQUAL(a.RetrieveAllAsString(), "0123456789abcdefghij");
+    // 来自别的池的块大小不同，归还时直接释放
+    BOOST_CHECK_EQUAL(large->CachedBlocks(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_move) {
+    bre::BufferChain chain1;
+    chain1.Append("Test data");
+    bre::BufferChain chain2(std::move(chain1));
+    BOOST_CHECK_EQUAL(chain2.ToString(), "Test data");
+    BOOST_CHECK_EQUAL(chain1.ReadableBytes(), 0);
+
+    chain1.Append("reuse");
+    chain2 = std::move(chain1);
+    BOOST_CHECK_EQUAL(chain2.ToString(), "reuse");
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+BOOST_AUTO_TEST_CASE(test_peek_iov) {
+    auto pool = std::make_shared<bre::BlockPool>(16);
+    bre::BufferChain chain(pool);
+    chain.Append(std::string(40, 'p'));
+    chain.Retrieve(4);
+
+    struct iovec iov[8];
+    const size_t count = chain.PeekIov(iov, 8);
+    BOOST_CHECK_EQUAL(count, 3);
+    BOOST_CHECK_EQUAL(iov[0].iov_len, 12);
+    BOOST_CHECK_EQUAL(iov[1].iov_len, 16);
+    BOOST_CHECK_EQUAL(iov[2].iov_len, 8);
+    BOOST_CHECK_EQUAL(chain.ReadableBytes(), 36);  // Peek 不取出
+}
+
+BOOST_AUTO_TEST_CASE(test_write_fd_and_read_fd) {
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+
+    auto pool = std::make_shared<bre::BlockPool>(16);
+    bre::BufferChain out(pool);
+    std::string data;
+    for (int i = 0; i < 100; ++i) {
+        data += static_cast<char>('a' + i % 26);
+    }
+    out.Append(data);
+
+    int savedErrno = 0;
+    BOOST_CHECK_EQUAL(out.WriteFd(fds[1], &savedErrno), 100);
+    BOOST_CHECK_EQUAL(out.ReadableBytes(), 0);
+
+    bre::BufferChain in(pool);
+    in.Append("head:");
+    BOOST_CHECK_EQUAL(in.ReadFd(fds[0], &savedErrno), 100);
+    BOOST_CHECK_EQUAL(in.ToString(), "head:" + data);
+
+    BOOST_CHECK_EQUAL(in.ReadFd(-1, &savedErrno), -1);
+    BOOST_CHECK_EQUAL(savedErrno, EBADF);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+BOOST_AUTO_TEST_CASE(test_read_fd_eof) {
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(::pipe(fds), 0);
+    ::close(fds[1]);
+
+    // 空链还没有尾块
+    bre::BufferChain empty;
+    int savedErrno = 0;
+    BOOST_CHECK_EQUAL(empty.ReadFd(fds[0], &savedErrno), 0);
+    BOOST_CHECK_EQUAL(empty.ReadableBytes(), 0);
+    BOOST_CHECK_EQUAL(empty.BlockCount(), 0);
+
+    // 尾块已写满，没有可写空间
+    auto pool = std::make_shared<bre::BlockPool>(16);
+    bre::BufferChain full(pool);
+    full.Append(std::string(16, 'f'));
+    BOOST_CHECK_EQUAL(full.ReadFd(fds[0], &savedErrno), 0);
+    BOOST_CHECK_EQUAL(full.BlockCount(), 1);
+    BOOST_CHECK_EQUAL(full.ToString(), std::string(16, 'f'));
+    BOOST_CHECK_EQUAL(savedErrno, 0);
+
+    ::close(fds[0]);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
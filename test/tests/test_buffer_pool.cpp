@@ -0,0 +1,137 @@
+#define BOOST_TEST_MODULE BufferPoolTest
+#include <boost/test/included/unit_test.hpp>
+#include "breutil/buffer_pool.hpp"
+#include <string>
+#include <thread>
+#include <type_traits>
+
+BOOST_AUTO_TEST_SUITE(BufferPoolTestSuite)
+
+BOOST_AUTO_TEST_CASE(test_acquire_release_reuses_buffer) {
+    auto& pool = bre::BufferPool::Local();
+    pool.Trim();
+    const auto before = pool.GetStats();
+
+    bre::Buffer* first = nullptr;
+    {
+        auto handle = pool.Acquire();
+        BOOST_REQUIRE(handle);
+        BOOST_CHECK(handle->WritableBytes() >= bre::Buffer::kInitialSize);
+        handle->Append("request data");
+        first = handle.Get();
+    }
+
+    auto handle = pool.Acquire();
+    BOOST_CHECK(handle.Get() == first);  // 同一个对象，保留了容量
+    BOOST_CHECK_EQUAL(handle->ReadableBytes(), 0);  // 归还时已清空
+
+    const auto after = pool.GetStats();
+    BOOST_CHECK_EQUAL(after.misses - before.misses, 1);
+    BOOST_CHECK_EQUAL(after.hits - before.hits, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_size_classes) {
+    auto& pool = bre::BufferPool::Local();
+    pool.Trim();
+
+    auto small = pool.Acquire(100);
+    auto medium = pool.Acquire(5000);
+    BOOST_CHECK(small->WritableBytes() >= 100);
+    BOOST_CHECK_EQUAL(medium->WritableBytes(), 16 * 1024u);
+
+    bre::Buffer* mediumPtr = medium.Get();
+    medium.Release();
+    small.Release();
+    auto stats = pool.GetStats();
+    BOOST_CHECK_EQUAL(stats.retainedBuffers, 2);
+    BOOST_CHECK_EQUAL(stats.retainedBytes, 1024 + 16 * 1024 + 2 * bre::Buffer::kPrependSize);
+
+    // 10000 字节落在 16K 级，取到刚归还的 Buffer
+    auto again = pool.Acquire(10000);
+    BOOST_CHECK(again.Get() == mediumPtr);
+}
+
+BOOST_AUTO_TEST_CASE(test_grown_buffer_changes_class) {
+    auto& pool = bre::BufferPool::Local();
+    pool.Trim();
+
+    bre::Buffer* ptr = nullptr;
+    {
+        auto handle = pool.Acquire(1024);
+        handle->Append(std::string(5000, 'g'));  // 扩容到更高一级
+        ptr = handle.Get();
+    }
+    auto handle = pool.Acquire(4096);
+    BOOST_CHECK(handle.Get() == ptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_oversized_and_moved_buffers_are_dropped) {
+    auto& pool = bre::BufferPool::Local();
+    pool.Trim();
+    const auto before = pool.GetStats();
+    {
+        auto huge = pool.Acquire(8 * 1024 * 1024);
+        BOOST_CHECK(huge->WritableBytes() >= 8 * 1024 * 1024u);
+    }
+    {
+        auto handle = pool.Acquire();
+        bre::Buffer stolen(std::move(*handle));
+    }
+    const auto after = pool.GetStats();
+    BOOST_CHECK_EQUAL(after.dropped - before.dropped, 2);
+    BOOST_CHECK_EQUAL(after.retainedBuffers, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_steady_state_hit_rate) {
+    auto& pool = bre::BufferPool::Local();
+    pool.Trim();
+    const auto before = pool.GetStats();
+    for (int i = 0; i < 1000; ++i) {
+        auto in = pool.Acquire();
+        auto out = pool.Acquire(4096);
+        in->Append("ping");
+        out->Append("pong");
+    }
+    const auto after = pool.GetStats();
+    BOOST_CHECK_EQUAL(after.misses - before.misses, 2);
+    BOOST_CHECK_EQUAL(after.hits - before.hits, 1998);
+}
+
+BOOST_AUTO_TEST_CASE(test_per_thread_pools) {
+    auto& mainPool = bre::BufferPool::Local();
+    mainPool.Trim();
+    auto handle = mainPool.Acquire();
+
+    bre::BufferPool* workerPool = nullptr;
+    size_t workerRetained = 0;
+    std::thread worker([&] {
+        workerPool = &bre::BufferPool::Local();
+        handle.Release();  // 在其他线程释放，归还到该线程的池
+        workerRetained = workerPool->GetStats().retainedBuffers;
+    });
+    worker.join();
+
+    BOOST_CHECK(workerPool != &mainPool);
+    BOOST_CHECK_EQUAL(workerRetained, 1);
+    BOOST_CHECK_EQUAL(mainPool.GetStats().retainedBuffers, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_only_thread_local_pools) {
+    // 只有 Local() 一个池，不会出现借出后归还到别的池、统计失真的情况
+    static_assert(!std::is_default_constructible_v<bre::BufferPool>);
+}
+
+BOOST_AUTO_TEST_CASE(test_handle_outlives_thread_pool) {
+    bool acquired = false;
+    std::thread worker([&acquired] {
+        // 先于池构造的 thread_local 晚于池析构，释放时池已不在
+        thread_local bre::BufferPool::Handle held;
+        held = bre::BufferPool::Local().Acquire();
+        held->Append("kept until thread exit");
+        acquired = static_cast<bool>(held);
+    });
+    worker.join();
+    BOOST_CHECK(acquired);
+}
+
+BOOST_AUTO_TEST_SUITE_END()